@@ -25,6 +25,11 @@ extern "C" {
 
 typedef size_t (* jpg_out_cb)(void * arg, size_t index, const void* data, size_t len);
 
+/**
+ * @brief Line by line JPEG encoder, see jpg_stream_begin()
+ */
+typedef struct jpg_stream_s jpg_stream_t;
+
 /**
  * @brief Convert image buffer to JPEG
  *
@@ -53,6 +58,50 @@ bool fmt2jpg_cb(uint8_t *src, size_t src_len, uint16_t width, uint16_t height, p
  */
 bool frame2jpg_cb(camera_fb_t * fb, uint8_t quality, jpg_out_cb cb, void * arg);
 
+/**
+ * @brief Start encoding a JPEG image that is fed line by line
+ *
+ * Only a few lines are held at a time, so the raw image never has to be in
+ * memory as a whole. The output goes to the callback as it is produced.
+ *
+ * @param width     Width in pixels of the image
+ * @param height    Height in pixels of the image
+ * @param format    Format of the lines: RGB565, RGB888, YUYV or GRAYSCALE
+ * @param quality   JPEG quality of the resulting image
+ * @param cb        Callback to be called to write the bytes of the output JPEG
+ * @param arg       Pointer to be passed to the callback
+ *
+ * @return encoder to pass to jpg_stream_write(), NULL on failure
+ */
+jpg_stream_t * jpg_stream_begin(uint16_t width, uint16_t height, pixformat_t format, uint8_t quality, jpg_out_cb cb, void * arg);
+
+/**
+ * @brief Encode the next lines of the image
+ *
+ * @param stream    Encoder from jpg_stream_begin()
+ * @param src       Lines in the format given to jpg_stream_begin()
+ * @param lines     Number of lines in src
+ *
+ * @return true on success
+ */
+bool jpg_stream_write(jpg_stream_t * stream, const uint8_t * src, size_t lines);
+
+/**
+ * @brief Finish the image after all lines were written and free the encoder
+ *
+ * @param stream    Encoder from jpg_stream_begin()
+ *
+ * @return length of the JPEG data, 0 on failure
+ */
+size_t jpg_stream_end(jpg_stream_t * stream);
+
+/**
+ * @brief Free the encoder without finishing the image
+ *
+ * @param stream    Encoder from jpg_stream_begin()
+ */
+void jpg_stream_abort(jpg_stream_t * stream);
+
 /**
  * @brief Convert image buffer to JPEG buffer
  *
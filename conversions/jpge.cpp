@@ -65,15 +65,6 @@ namespace jpge {
 
     const int YR = 19595, YG = 38470, YB = 7471, CB_R = -11059, CB_G = -21709, CB_B = 32768, CR_R = 32768, CR_G = -27439, CR_B = -5329;
 
-    static int32 m_last_quality = 0;
-    static int32 m_quantization_tables[2][64];
-
-    static bool m_huff_initialized = false;
-    static uint m_huff_codes[4][256];
-    static uint8 m_huff_code_sizes[4][256];
-    static uint8 m_huff_bits[4][17];
-    static uint8 m_huff_val[4][256];
-
     static inline uint8 clamp(int i) {
         if (i < 0) {
             i = 0;
@@ -143,7 +134,7 @@ namespace jpge {
     }
 
     // Compute the actual canonical Huffman codes/code sizes given the JPEG huff bits and val arrays.
-    static void compute_huffman_table(uint *codes, uint8 *code_sizes, uint8 *bits, uint8 *val)
+    static void compute_huffman_table(uint *codes, uint8 *code_sizes, const uint8 *bits, const uint8 *val)
     {
         int i, l, last_p, si;
         static uint8 huff_size[257];
@@ -178,6 +169,29 @@ namespace jpge {
         }
     }
 
+    // The Huffman codes come from the standard tables only, so they are built
+    // once and shared. The quantization tables depend on the quality and
+    // belong to each encoder.
+    struct huffman_tables {
+        uint codes[4][256];
+        uint8 code_sizes[4][256];
+
+        huffman_tables()
+        {
+            compute_huffman_table(codes[0+0], code_sizes[0+0], s_dc_lum_bits, s_dc_lum_val);
+            compute_huffman_table(codes[2+0], code_sizes[2+0], s_ac_lum_bits, s_ac_lum_val);
+            compute_huffman_table(codes[0+1], code_sizes[0+1], s_dc_chroma_bits, s_dc_chroma_val);
+            compute_huffman_table(codes[2+1], code_sizes[2+1], s_ac_chroma_bits, s_ac_chroma_val);
+        }
+    };
+
+    // Built on first use; the initialization of a local static is thread-safe.
+    static const huffman_tables &get_huffman_tables()
+    {
+        static const huffman_tables tables;
+        return tables;
+    }
+
     void jpeg_encoder::flush_output_buffer()
     {
         if (m_out_buf_left != JPGE_OUT_BUF_SIZE) {
@@ -268,7 +282,7 @@ namespace jpge {
     }
 
     // Emit Huffman table.
-    void jpeg_encoder::emit_dht(uint8 *bits, uint8 *val, int index, bool ac_flag)
+    void jpeg_encoder::emit_dht(const uint8 *bits, const uint8 *val, int index, bool ac_flag)
     {
         emit_marker(M_DHT);
 
@@ -289,11 +303,11 @@ namespace jpge {
     // Emit all Huffman tables.
     void jpeg_encoder::emit_dhts()
     {
-        emit_dht(m_huff_bits[0+0], m_huff_val[0+0], 0, false);
-        emit_dht(m_huff_bits[2+0], m_huff_val[2+0], 0, true);
+        emit_dht(s_dc_lum_bits, s_dc_lum_val, 0, false);
+        emit_dht(s_ac_lum_bits, s_ac_lum_val, 0, true);
         if (m_num_components == 3) {
-            emit_dht(m_huff_bits[0+1], m_huff_val[0+1], 1, false);
-            emit_dht(m_huff_bits[2+1], m_huff_val[2+1], 1, true);
+            emit_dht(s_dc_chroma_bits, s_dc_chroma_val, 1, false);
+            emit_dht(s_ac_chroma_bits, s_ac_chroma_val, 1, true);
         }
     }
 
@@ -405,8 +419,8 @@ namespace jpge {
     {
         int i, j, run_len, nbits, temp1, temp2;
         int16 *pSrc = m_coefficient_array;
-        uint *codes[2];
-        uint8 *code_sizes[2];
+        const uint *codes[2];
+        const uint8 *code_sizes[2];
 
         if (component_num == 0)
         {
@@ -613,25 +627,12 @@ namespace jpge {
         for (int i = 1; i < m_mcu_y; i++)
             m_mcu_lines[i] = m_mcu_lines[i-1] + m_image_bpl_mcu;
 
-        if(m_last_quality != m_params.m_quality){
-            m_last_quality = m_params.m_quality;
-            compute_quant_table(m_quantization_tables[0], s_std_lum_quant);
-            compute_quant_table(m_quantization_tables[1], s_std_croma_quant);
-        }
+        compute_quant_table(m_quantization_tables[0], s_std_lum_quant);
+        compute_quant_table(m_quantization_tables[1], s_std_croma_quant);
 
-        if(!m_huff_initialized){
-            m_huff_initialized = true;
-
-            memcpy(m_huff_bits[0+0], s_dc_lum_bits, 17);    memcpy(m_huff_val[0+0], s_dc_lum_val, DC_LUM_CODES);
-            memcpy(m_huff_bits[2+0], s_ac_lum_bits, 17);    memcpy(m_huff_val[2+0], s_ac_lum_val, AC_LUM_CODES);
-            memcpy(m_huff_bits[0+1], s_dc_chroma_bits, 17); memcpy(m_huff_val[0+1], s_dc_chroma_val, DC_CHROMA_CODES);
-            memcpy(m_huff_bits[2+1], s_ac_chroma_bits, 17); memcpy(m_huff_val[2+1], s_ac_chroma_val, AC_CHROMA_CODES);
-
-            compute_huffman_table(&m_huff_codes[0+0][0], &m_huff_code_sizes[0+0][0], m_huff_bits[0+0], m_huff_val[0+0]);
-            compute_huffman_table(&m_huff_codes[2+0][0], &m_huff_code_sizes[2+0][0], m_huff_bits[2+0], m_huff_val[2+0]);
-            compute_huffman_table(&m_huff_codes[0+1][0], &m_huff_code_sizes[0+1][0], m_huff_bits[0+1], m_huff_val[0+1]);
-            compute_huffman_table(&m_huff_codes[2+1][0], &m_huff_code_sizes[2+1][0], m_huff_bits[2+1], m_huff_val[2+1]);
-        }
+        const huffman_tables &huff = get_huffman_tables();
+        m_huff_codes = huff.codes;
+        m_huff_code_sizes = huff.code_sizes;
 
         m_out_buf_left = JPGE_OUT_BUF_SIZE;
         m_pOut_buf = m_out_buf;
@@ -4,6 +4,8 @@
 #ifndef JPEG_ENCODER_H
 #define JPEG_ENCODER_H
 
+#include <stddef.h>
+
 namespace jpge
 {
     typedef unsigned char  uint8;
@@ -47,7 +49,7 @@ namespace jpge
         public:
             virtual ~output_stream() { };
             virtual bool put_buf(const void* Pbuf, int len) = 0;
-            virtual uint get_size() const = 0;
+            virtual size_t get_size() const = 0;
     };
     
     // Lower level jpeg_encoder class - useful if more control is needed than the above helper functions.
@@ -93,6 +95,9 @@ namespace jpge
             uint8 m_mcu_y_ofs;
             sample_array_t m_sample_array[64];
             int16 m_coefficient_array[64];
+            int32 m_quantization_tables[2][64];
+            const uint (*m_huff_codes)[256];
+            const uint8 (*m_huff_code_sizes)[256];
 
             int m_last_dc_val[3];
             uint8 m_out_buf[JPGE_OUT_BUF_SIZE];
@@ -115,7 +120,7 @@ namespace jpge
             void emit_jfif_app0();
             void emit_dqt();
             void emit_sof();
-            void emit_dht(uint8 *bits, uint8 *val, int index, bool ac_flag);
+            void emit_dht(const uint8 *bits, const uint8 *val, int index, bool ac_flag);
             void emit_dhts();
             void emit_sos();
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 #include <stddef.h>
 #include <string.h>
+#include <new>
 #include "esp_spiram.h"
 #include "esp_attr.h"
 #include "soc/efuse_reg.h"
@@ -155,6 +156,109 @@ public:
     }
 };
 
+struct jpg_stream_s {
+    callback_stream stream;
+    jpge::jpeg_encoder encoder;
+    pixformat_t format;
+    uint16_t width;
+    size_t line_len;
+    uint8_t * line;
+
+    jpg_stream_s(jpg_out_cb cb, void * arg) : stream(cb, arg), line(NULL) { }
+};
+
+static void jpg_stream_free(jpg_stream_t * s)
+{
+    s->encoder.deinit();
+    free(s->line);
+    s->~jpg_stream_s();
+    free(s);
+}
+
+jpg_stream_t * jpg_stream_begin(uint16_t width, uint16_t height, pixformat_t format, uint8_t quality, jpg_out_cb cb, void * arg)
+{
+    int num_channels = 3;
+    size_t line_len = width * 2;
+    jpge::params comp_params = jpge::params();
+    comp_params.m_subsampling = jpge::H2V2;
+
+    if(format == PIXFORMAT_GRAYSCALE) {
+        num_channels = 1;
+        line_len = width;
+        comp_params.m_subsampling = jpge::Y_ONLY;
+    } else if(format == PIXFORMAT_RGB888) {
+        line_len = width * 3;
+    } else if(format != PIXFORMAT_RGB565 && format != PIXFORMAT_YUV422) {
+        ESP_LOGE(TAG, "JPG stream does not support format %d", format);
+        return NULL;
+    }
+
+    if(!quality) {
+        quality = 1;
+    } else if(quality > 100) {
+        quality = 100;
+    }
+    comp_params.m_quality = quality;
+
+    void * mem = _malloc(sizeof(jpg_stream_t));
+    if(!mem) {
+        ESP_LOGE(TAG, "JPG stream malloc failed");
+        return NULL;
+    }
+    jpg_stream_t * s = new (mem) jpg_stream_t(cb, arg);
+    s->format = format;
+    s->width = width;
+    s->line_len = line_len;
+    if(num_channels > 1) {
+        s->line = (uint8_t*)_malloc(width * num_channels);
+        if(!s->line) {
+            ESP_LOGE(TAG, "Scan line malloc failed");
+            jpg_stream_free(s);
+            return NULL;
+        }
+    }
+    if (!s->encoder.init(&s->stream, width, height, num_channels, comp_params)) {
+        ESP_LOGE(TAG, "JPG encoder init failed");
+        jpg_stream_free(s);
+        return NULL;
+    }
+    return s;
+}
+
+bool jpg_stream_write(jpg_stream_t * stream, const uint8_t * src, size_t lines)
+{
+    for (size_t i = 0; i < lines; i++) {
+        const uint8_t * line = src;
+        if (stream->line) {
+            convert_line_format((uint8_t *)src, stream->format, stream->line, stream->width, 3, 0);
+            line = stream->line;
+        }
+        if (!stream->encoder.process_scanline(line)) {
+            ESP_LOGE(TAG, "JPG process line failed");
+            return false;
+        }
+        src += stream->line_len;
+    }
+    return true;
+}
+
+size_t jpg_stream_end(jpg_stream_t * stream)
+{
+    size_t len = 0;
+    if (stream->encoder.process_scanline(NULL)) {
+        len = stream->stream.get_size();
+    } else {
+        ESP_LOGE(TAG, "JPG image finish failed");
+    }
+    jpg_stream_free(stream);
+    return len;
+}
+
+void jpg_stream_abort(jpg_stream_t * stream)
+{
+    jpg_stream_free(stream);
+}
+
 bool fmt2jpg_cb(uint8_t *src, size_t src_len, uint16_t width, uint16_t height, pixformat_t format, uint8_t quality, jpg_out_cb cb, void * arg)
 {
     callback_stream dst_stream(cb, arg);
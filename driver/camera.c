@@ -33,11 +33,15 @@
 #include "driver/rtc_io.h"
 #include "driver/periph_ctrl.h"
 #include "esp_intr_alloc.h"
+#include "esp_timer.h"
 #include "sensor.h"
 #include "sccb.h"
+#include "reg_cache.h"
 #include "myesp_camera.h"
 #include "camera_common.h"
 #include "xclk.h"
+#include "yuv.h"
+#include "img_converters.h"
 #if CONFIG_OV2640_SUPPORT
 #include "ov2640.h"
 #endif
@@ -53,6 +57,9 @@
 #if CONFIG_OV5642_SUPPORT
 #include "ov5642.h"
 #endif
+#if CONFIG_CAMERA_SIM_BACKEND
+#include "camera_sim_bus.h"
+#endif
 
 typedef enum {
     CAMERA_NONE = 0,
@@ -62,6 +69,7 @@ typedef enum {
     CAMERA_OV3660 = 3660,
     CAMERA_OV5640 = 5640,
     CAMERA_OV5642 = 5642,
+    CAMERA_SIMULATED = 0xFFFF,
 } camera_model_t;
 
 #define REG_PID        0x0A
@@ -72,6 +80,33 @@ typedef enum {
 #define REG16_CHIDH     0x300A
 #define REG16_CHIDL     0x300B
 
+#ifndef CONFIG_CAMERA_DMA_BATCH_LINES
+#define CONFIG_CAMERA_DMA_BATCH_LINES 1
+#endif
+
+#if CONFIG_CAMERA_SIM_BACKEND
+// the simulated bus calls the interrupt handlers from a task
+#define camera_yield_from_isr() taskYIELD()
+#else
+#define camera_yield_from_isr() portYIELD_FROM_ISR()
+#endif
+
+#if CONFIG_CAMERA_STAGE_STATS
+#define CAMERA_STAGE_START(t)       int64_t t = esp_timer_get_time()
+#define CAMERA_STAGE_END(t, total)  (total) += esp_timer_get_time() - (t)
+#else
+#define CAMERA_STAGE_START(t)
+#define CAMERA_STAGE_END(t, total)
+#endif
+
+#define LATENCY_BUCKETS     24      // bucket b holds 2^(b-1) to 2^b - 1 us, the last one everything from 2^22 us (4.2 s) up
+
+#define JPEG_SIZE_HISTORY   32      // JPEG frame sizes kept for adaptive buffer sizing
+#define JPEG_FB_ALIGN       4096    // adaptive buffer sizes are rounded up to this
+#define CTRL_QUEUE_LEN      16      // sensor changes waiting for a frame boundary
+#define CTRL_HISTORY        16      // applied changes whose status can be read back, power of two
+#define CTRL_WAIT_MS        200     // longest wait for VSYNC before applying changes anyway
+
 #if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
 #include "esp32-hal-log.h"
 #define TAG ""
@@ -88,6 +123,10 @@ typedef struct camera_fb_s {
     size_t width;
     size_t height;
     pixformat_t format;
+    int64_t timestamp;
+    uint32_t seq;
+    uint32_t dropped;
+    bool partial;
     size_t size;
     uint8_t ref;
     uint8_t bad;
@@ -100,24 +139,106 @@ typedef struct fb_s {
     struct fb_s * next;
 } fb_item_t;
 
+/*
+ * Single producer (I2S/VSYNC ISR) / single consumer (dma_filter_task) ring
+ * of filled DMA descriptor indexes. SIZE_MAX entries mark the end of a frame,
+ * DMA_RING_FRAME_PARTIAL the end of a frame that is missing lines.
+ * DMA_RING_DATA_LOST stands where descriptors were dropped, so the filter task
+ * marks the frame they belonged to as bad, not the one it is finishing.
+ * Only descriptor entries hold a DMA buffer, the markers take a slot only.
+ * It lives in internal RAM and every index is only ever written by one side,
+ * so no locking is needed. The consumer is notified only when the ring goes
+ * from empty to non-empty, which gives one wakeup per batch of descriptors.
+ */
+#define DMA_RING_FRAME_PARTIAL  (SIZE_MAX - 1)
+#define DMA_RING_DATA_LOST      (SIZE_MAX - 2)
+
+typedef struct {
+    volatile size_t head;       // written by the ISR only
+    volatile size_t tail;       // written by the filter task only
+    volatile size_t desc_pushed;    // descriptor entries, written by the ISR only
+    volatile size_t desc_released;  // descriptor entries done with, written by the filter task only
+    size_t peek_overruns;       // written by the filter task only, overruns when the entry was taken
+    size_t mask;
+    size_t overruns;            // descriptors lost because the ring was full
+    bool lost;                  // written by the ISR only, DMA_RING_DATA_LOST goes before the next entry
+    size_t max_used;            // deepest the ring has been
+    size_t items[];
+} dma_ring_t;
+
+/*
+ * Latency histogram in microseconds. Bucket n > 0 counts values in
+ * [2^(n-1), 2^n), so an update is a count leading zeros and an increment
+ * and can be done from an ISR.
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t buckets[LATENCY_BUCKETS];
+} latency_hist_t;
+
+typedef struct {
+    camera_setter_t setter;
+    int value;
+    uint32_t ticket;
+} camera_ctrl_t;
+
+// Sensor change applied by the control task
 typedef struct {
+    uint32_t ticket;
+    int result;                 // return value of the setter
+    int64_t applied_time;       // esp_timer time when the batch was written
+    uint32_t seq;               // first frame started after applied_time, set by the filter task
+} camera_ctrl_status_t;
+
+typedef struct esp_camera_s {
     camera_config_t config;
     sensor_t sensor;
+    i2s_dev_t* i2s;             // I2S peripheral selected by config.i2s_port
 
     camera_fb_int_t *fb;
-    size_t fb_size;
+    size_t fb_size;             // target size of the frame buffers
+    size_t fb_size_max;         // upper bound for adaptive JPEG buffers
     size_t data_size;
 
+    size_t jpeg_sizes[JPEG_SIZE_HISTORY];   // written by the filter task, read when resizing
+    size_t jpeg_size_pos;
+    size_t jpeg_size_count;
+    size_t jpeg_max_len;
+    uint32_t fb_overflows;
+
     size_t width;
     size_t height;
     size_t in_bytes_per_pixel;
     size_t fb_bytes_per_pixel;
+    pixformat_t fb_format;          // format of the frame buffer, differs from the sensor when converting
+    size_t fb_width;                // frame buffer geometry, after crop and decimation
+    size_t fb_height;
+    bool roi;                       // crop window or decimation in use, lines go through line_buf
+    size_t roi_x;
+    size_t roi_y;
+    size_t roi_step;                // decimation factor
+    size_t out_lines;               // lines stored in the current frame
+    uint8_t* line_buf;              // one filtered line, in internal RAM
+    size_t band_lines;              // lines per band in band mode or when encoding, 0 otherwise
+    size_t band_fill;               // lines in the band buffer not delivered yet
+    uint8_t* band_buf;              // band_lines lines, in internal RAM
+    bool jpeg_encode;               // frames are compressed in software, see CAMERA_CONVERT_JPEG
+    jpg_stream_t* jpeg_stream;      // encoder of the current frame
+    size_t band_next_y;             // frame line following the last one stored
 
     size_t dma_received_count;
     size_t dma_filtered_count;
     size_t dma_per_line;
     size_t dma_buf_width;
     size_t dma_sample_count;
+    size_t dma_batch;           // descriptors signalled per I2S interrupt
+    size_t dma_batch_sample_count;
+
+    size_t jpeg_len;            // length up to the JPEG end of image marker, 0 until it is found
+    bool jpeg_last_ff;          // last filtered byte was 0xFF, the marker may span two DMA buffers
 
     lldesc_t *dma_desc;
     dma_elem_t **dma_buf;
@@ -126,34 +247,121 @@ typedef struct {
 
     i2s_sampling_mode_t sampling_mode;
     dma_filter_t dma_filter;
+    dma_filter_t dma_filter_bytes;  // byte-wise dma_filter for unaligned destinations
     intr_handle_t i2s_intr_handle;
-    QueueHandle_t data_ready;
+    dma_ring_t *dma_ready;
+    size_t dma_overruns_reported;
     QueueHandle_t fb_in;
     QueueHandle_t fb_out;
 
     SemaphoreHandle_t frame_ready;
+    SemaphoreHandle_t vsync_sem;    // given by vsync_isr while a task waits for VSYNC
+    volatile bool vsync_waiting;
+    volatile bool bus_stopped;      // interrupts already on their way when the bus stopped do nothing
+    bool task_started;              // the frame was started by a task after VSYNC fell, maybe not in time
+    volatile bool stop_pending;     // camera_pause() waits for the interrupts to stop the bus at the frame end
+    volatile uint32_t fb_held;      // frame buffers taken with esp_camera_fb_get() and not returned
     TaskHandle_t dma_filter_task;
+
+    QueueHandle_t ctrl_queue;       // sensor changes for the control task
+    SemaphoreHandle_t ctrl_lock;    // keeps tickets in queue order
+    TaskHandle_t ctrl_task;
+    volatile bool ctrl_waiting;     // the control task waits for vsync_isr
+    uint32_t ctrl_next_ticket;
+    volatile uint32_t ctrl_applied; // last ticket written to the sensor
+    volatile uint32_t ctrl_resolved;    // last ticket whose first frame is known
+    camera_ctrl_status_t ctrl_history[CTRL_HISTORY];
+
+    int64_t frame_start_time;   // esp_timer time of the VSYNC that started the current frame
+    int64_t frame_period;       // frame-rate governor: microseconds between captured frames, 0 when off
+    int64_t next_frame_time;    // earliest start of the next captured frame
+    int64_t vsync_time;         // last VSYNC seen while streaming, to measure the sensor frame period
+    uint32_t frame_seq;         // sequence number of the next completed frame
+    uint32_t frames_dropped;    // total frames lost (bad, overflowed or overwritten)
+    uint32_t frames_dropped_reported;
+
+    // latency from VSYNC to each step of a frame's way to the application
+    latency_hist_t lat_dma;     // first DMA interrupt
+    latency_hist_t lat_filter;  // last DMA buffer filtered
+    latency_hist_t lat_done;    // frame handed to the application queue
+    latency_hist_t lat_get;     // frame returned by esp_camera_fb_get()
+
+    uint32_t bad_frames;        // frames with a bad header, missing data or no JPEG end marker
+    uint32_t queue_send_failures;
+    uint32_t fb_overwrites;     // queued frames replaced by a newer one
+    uint32_t partial_frames;    // uncompressed frames delivered with missing lines
+    uint32_t skipped_frames;    // frames left uncaptured by the frame-rate governor
+    bool frame_partial;         // the frame being finished ended before its last line
+
+    uint64_t isr_time;          // CPU time per capture stage, with CONFIG_CAMERA_STAGE_STATS
+    uint64_t filter_time;
+    uint64_t finish_time;
 } camera_state_t;
 
-camera_state_t* s_state = NULL;
+// handle used by the esp_camera_* functions that take no handle
+static camera_state_t* s_state = NULL;
 
-static void i2s_init();
-static int i2s_run();
+// I2S peripherals that can run in camera mode. The data input signals of a
+// port are numbered consecutively from D0.
+typedef struct {
+    i2s_dev_t* dev;
+    periph_module_t module;
+    int intr_source;
+    int sig_data_in0;
+    int sig_v_sync;
+    int sig_h_sync;
+    int sig_h_enable;
+    int sig_ws_in;
+} i2s_port_desc_t;
+
+static const i2s_port_desc_t s_i2s_ports[] = {
+    { &I2S0, PERIPH_I2S0_MODULE, ETS_I2S0_INTR_SOURCE, I2S0I_DATA_IN0_IDX, I2S0I_V_SYNC_IDX, I2S0I_H_SYNC_IDX, I2S0I_H_ENABLE_IDX, I2S0I_WS_IN_IDX },
+    { &I2S1, PERIPH_I2S1_MODULE, ETS_I2S1_INTR_SOURCE, I2S1I_DATA_IN0_IDX, I2S1I_V_SYNC_IDX, I2S1I_H_SYNC_IDX, I2S1I_H_ENABLE_IDX, I2S1I_WS_IN_IDX },
+};
+#define I2S_PORT_COUNT  (sizeof(s_i2s_ports) / sizeof(s_i2s_ports[0]))
+
+static camera_state_t* s_i2s_owner[I2S_PORT_COUNT];
+
+// Held by the interrupts of a port, and by a task stopping the bus under them.
+// Not in camera_state_t: spinlocks have to be in internal RAM
+static portMUX_TYPE s_i2s_lock[I2S_PORT_COUNT] = { portMUX_INITIALIZER_UNLOCKED, portMUX_INITIALIZER_UNLOCKED };
+
+// Held around every use of the sensor setters by the driver. The cameras share
+// the SCCB bus, the register caches and state in the sensor drivers
+static SemaphoreHandle_t s_sensor_lock = NULL;
+
+static void i2s_init(camera_state_t* cam);
+static int i2s_run(camera_state_t* cam);
 static void IRAM_ATTR vsync_isr(void* arg);
 static void IRAM_ATTR i2s_isr(void* arg);
-static esp_err_t dma_desc_init();
-static void dma_desc_deinit();
+static esp_err_t dma_desc_init(camera_state_t* cam);
+static void dma_desc_deinit(camera_state_t* cam);
+static esp_err_t dma_ring_init(camera_state_t* cam);
+static void dma_ring_deinit(camera_state_t* cam);
 static void dma_filter_task(void *pvParameters);
+static void camera_ctrl_task(void *pvParameters);
 static void dma_filter_grayscale(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst);
 static void dma_filter_grayscale_highspeed(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst);
 static void dma_filter_yuyv(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst);
 static void dma_filter_yuyv_highspeed(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst);
 static void dma_filter_jpeg(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst);
-static void i2s_stop(bool* need_yield);
-
-static bool is_hs_mode()
+static void dma_filter_jpeg_packed(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst);
+static void dma_filter_grayscale_bytes(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst);
+static void dma_filter_grayscale_highspeed_bytes(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst);
+static void dma_filter_yuyv_bytes(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst);
+static void dma_filter_yuyv_highspeed_bytes(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst);
+static void dma_filter_jpeg_bytes(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst);
+static void dma_filter_jpeg_packed_bytes(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst);
+static void dma_filter_yuyv_rgb565(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst);
+static void dma_filter_yuyv_rgb565_highspeed(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst);
+static void dma_filter_yuyv_rgb888(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst);
+static void dma_filter_yuyv_rgb888_highspeed(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst);
+static void i2s_stop(camera_state_t* cam, bool partial, bool* need_yield);
+static void i2s_stop_bus(camera_state_t* cam);
+
+static bool is_hs_mode(camera_state_t* cam)
 {
-    return s_state->config.xclk_freq_hz > 10000000;
+    return cam->config.xclk_freq_hz > 10000000;
 }
 
 static size_t i2s_bytes_per_sample(i2s_sampling_mode_t mode)
@@ -171,6 +379,50 @@ static size_t i2s_bytes_per_sample(i2s_sampling_mode_t mode)
     }
 }
 
+static void IRAM_ATTR latency_add(latency_hist_t* h, int64_t us)
+{
+    uint32_t v = (us < 0) ? 0 : (us > UINT32_MAX) ? UINT32_MAX : (uint32_t) us;
+    size_t b = v ? 32 - __builtin_clz(v) : 0;
+    if (b >= LATENCY_BUCKETS) {
+        b = LATENCY_BUCKETS - 1;
+    }
+    h->buckets[b]++;
+    if (!h->count || v < h->min) {
+        h->min = v;
+    }
+    if (v > h->max) {
+        h->max = v;
+    }
+    h->sum += v;
+    h->count++;
+}
+
+static void latency_read(const latency_hist_t* h, camera_latency_t* out)
+{
+    memset(out, 0, sizeof(*out));
+    uint32_t count = h->count;
+    if (!count) {
+        return;
+    }
+    out->count = count;
+    out->min_us = h->min;
+    out->max_us = h->max;
+    out->avg_us = h->sum / count;
+    //p99 is the upper end of the bucket holding it, so it is at most 2x high
+    uint32_t rank = count - count / 100;
+    uint32_t seen = 0;
+    for (size_t b = 0; b < LATENCY_BUCKETS; b++) {
+        seen += h->buckets[b];
+        if (seen >= rank) {
+            //the last bucket has no upper end
+            uint32_t top = (b == LATENCY_BUCKETS - 1) ? h->max : b ? (uint32_t)((1ULL << b) - 1) : 0;
+            out->p99_us = (top < h->max) ? top : h->max;
+            break;
+        }
+    }
+}
+
+#if !CONFIG_CAMERA_SIM_BACKEND
 static int IRAM_ATTR _gpio_get_level(gpio_num_t gpio_num)
 {
     if (gpio_num < 32) {
@@ -179,68 +431,170 @@ static int IRAM_ATTR _gpio_get_level(gpio_num_t gpio_num)
         return (GPIO.in1.data >> (gpio_num - 32)) & 0x1;
     }
 }
+#endif
+
+static void IRAM_ATTR vsync_intr_disable(camera_state_t* cam)
+{
+#if CONFIG_CAMERA_SIM_BACKEND
+    sim_bus_vsync_intr_enable(cam->config.i2s_port, false);
+#else
+    gpio_set_intr_type((gpio_num_t)cam->config.pin_vsync, GPIO_INTR_DISABLE);
+#endif
+}
+
+static void vsync_intr_enable(camera_state_t* cam)
+{
+#if CONFIG_CAMERA_SIM_BACKEND
+    sim_bus_vsync_intr_enable(cam->config.i2s_port, true);
+#else
+    gpio_set_intr_type((gpio_num_t)cam->config.pin_vsync, GPIO_INTR_NEGEDGE);
+#endif
+}
 
-static void IRAM_ATTR vsync_intr_disable()
+static int IRAM_ATTR vsync_get_level(camera_state_t* cam)
 {
-    gpio_set_intr_type((gpio_num_t)s_state->config.pin_vsync, GPIO_INTR_DISABLE);
+#if CONFIG_CAMERA_SIM_BACKEND
+    return sim_bus_vsync_level(cam->config.i2s_port);
+#else
+    return _gpio_get_level((gpio_num_t)cam->config.pin_vsync);
+#endif
+}
+
+static inline void IRAM_ATTR i2s_intr_enable(camera_state_t* cam)
+{
+#if CONFIG_CAMERA_SIM_BACKEND
+    sim_bus_i2s_intr_enable(cam->config.i2s_port, true);
+#else
+    esp_intr_enable(cam->i2s_intr_handle);
+#endif
+}
+
+static inline void IRAM_ATTR i2s_intr_disable(camera_state_t* cam)
+{
+#if CONFIG_CAMERA_SIM_BACKEND
+    sim_bus_i2s_intr_enable(cam->config.i2s_port, false);
+#else
+    esp_intr_disable(cam->i2s_intr_handle);
+#endif
+}
+
+// point the DMA at a descriptor and start it
+static inline void IRAM_ATTR i2s_dma_start(camera_state_t* cam, lldesc_t* desc)
+{
+    cam->i2s->in_link.addr = (uint32_t) desc;
+    cam->i2s->in_link.start = 1;
+#if CONFIG_CAMERA_SIM_BACKEND
+    sim_bus_dma_start(cam->config.i2s_port, desc);
+#endif
 }
 
-static void vsync_intr_enable()
+/*
+ * Block until the next falling edge of VSYNC. Only for when the bus is not
+ * running: vsync_isr skips the capture logic and just wakes the waiting task.
+ */
+static esp_err_t vsync_wait_edge(camera_state_t* cam, TickType_t timeout)
 {
-    gpio_set_intr_type((gpio_num_t)s_state->config.pin_vsync, GPIO_INTR_NEGEDGE);
+    xSemaphoreTake(cam->vsync_sem, 0);
+    cam->vsync_waiting = true;
+    vsync_intr_enable(cam);
+    BaseType_t got = xSemaphoreTake(cam->vsync_sem, timeout);
+    vsync_intr_disable(cam);
+    cam->vsync_waiting = false;
+    return (got == pdTRUE) ? ESP_OK : ESP_ERR_TIMEOUT;
 }
 
-static int skip_frame()
+static int skip_frame(camera_state_t* cam)
 {
-    if (s_state == NULL) {
+    if (cam == NULL) {
         return -1;
     }
-    int64_t st_t = esp_timer_get_time();
-    while (_gpio_get_level((gpio_num_t)s_state->config.pin_vsync) == 0) {
-        if((esp_timer_get_time() - st_t) > 1000000LL){
-            goto timeout;
+    //the first edge may end a partial frame
+    for (int i = 0; i < 2; i++) {
+        if (vsync_wait_edge(cam, pdMS_TO_TICKS(1000)) != ESP_OK) {
+            ESP_LOGE(TAG, "Timeout waiting for VSYNC");
+            return -1;
         }
     }
-    while (_gpio_get_level((gpio_num_t)s_state->config.pin_vsync) != 0) {
-        if((esp_timer_get_time() - st_t) > 1000000LL){
-            goto timeout;
+    return 0;
+}
+
+// Time between two falling edges of VSYNC, with the bus not running
+static int64_t camera_measure_frame(camera_state_t* cam)
+{
+    int64_t start = 0;
+    for (int i = 0; i < 3; i++) {
+        if (vsync_wait_edge(cam, pdMS_TO_TICKS(1000)) != ESP_OK) {
+            ESP_LOGE(TAG, "Timeout waiting for VSYNC");
+            return -1;
         }
-    }
-    while (_gpio_get_level((gpio_num_t)s_state->config.pin_vsync) == 0) {
-        if((esp_timer_get_time() - st_t) > 1000000LL){
-            goto timeout;
+        int64_t now = esp_timer_get_time();
+        if (i == 2) {
+            return now - start;
         }
+        start = now;
     }
-    return 0;
-
-timeout:
-    ESP_LOGE(TAG, "Timeout waiting for VSYNC");
     return -1;
 }
 
-static void camera_fb_deinit()
+/*
+ * Frame-rate governor. The sensor is slowed down by a whole factor where it
+ * supports it, what is left is done by capturing only the frames that are due
+ * (camera_frame_due). Must run after every set_framesize, which restores the
+ * sensor timing.
+ */
+static esp_err_t camera_rate_init(camera_state_t* cam)
+{
+    cam->frame_period = 0;
+    if (!cam->config.target_fps) {
+        return ESP_OK;
+    }
+    int64_t period = 1000000 / cam->config.target_fps;
+    int64_t native = camera_measure_frame(cam);
+    if (native <= 0) {
+        return ESP_ERR_TIMEOUT;
+    }
+    //allow for some jitter in the measurement, a slightly slow sensor is better than skipping every other frame
+    int divider = (period + period / 16) / native;
+    if (divider > 1 && cam->sensor.set_frame_divider) {
+        if (cam->sensor.set_frame_divider(&cam->sensor, divider) == 0) {
+            //the new timing applies from the next frame
+            native = camera_measure_frame(cam);
+            if (native <= 0) {
+                return ESP_ERR_TIMEOUT;
+            }
+        } else {
+            ESP_LOGW(TAG, "Sensor frame divider %d failed, skipping frames instead", divider);
+        }
+    }
+    ESP_LOGI(TAG, "Sensor frame period %lld us, capturing every %lld us", native, period);
+    cam->frame_period = period;
+    cam->next_frame_time = 0;
+    return ESP_OK;
+}
+
+static void camera_fb_deinit(camera_state_t* cam)
 {
-    camera_fb_int_t * _fb1 = s_state->fb, * _fb2 = NULL;
-    while(s_state->fb) {
-        _fb2 = s_state->fb;
-        s_state->fb = _fb2->next;
+    camera_fb_int_t * _fb1 = cam->fb, * _fb2 = NULL;
+    while(cam->fb) {
+        _fb2 = cam->fb;
+        cam->fb = _fb2->next;
         if(_fb2->next == _fb1) {
-            s_state->fb = NULL;
+            cam->fb = NULL;
         }
         free(_fb2->buf);
         free(_fb2);
     }
 }
 
-static esp_err_t camera_fb_init(size_t count)
+static esp_err_t camera_fb_init(camera_state_t* cam, size_t count)
 {
     if(!count) {
         return ESP_ERR_INVALID_ARG;
     }
 
-    camera_fb_deinit();
+    camera_fb_deinit(cam);
 
-    ESP_LOGI(TAG, "Allocating %u frame buffers (%d KB total)", count, (s_state->fb_size * count) / 1024);
+    ESP_LOGI(TAG, "Allocating %u frame buffers (%d KB total)", count, (cam->fb_size * count) / 1024);
 
     camera_fb_int_t * _fb = NULL, * _fb1 = NULL, * _fb2 = NULL;
     for(size_t i = 0; i < count; i++) {
@@ -249,17 +603,17 @@ static esp_err_t camera_fb_init(size_t count)
             goto fail;
         }
         memset(_fb2, 0, sizeof(camera_fb_int_t));
-        _fb2->size = s_state->fb_size;
+        _fb2->size = cam->fb_size;
         _fb2->buf = (uint8_t*) heap_caps_calloc(_fb2->size, 1, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
         if(!_fb2->buf) {
-            ESP_LOGI(TAG, "Allocating %d KB frame buffer in PSRAM", s_state->fb_size / 1024);
+            ESP_LOGI(TAG, "Allocating %d KB frame buffer in PSRAM", cam->fb_size / 1024);
             _fb2->buf = (uint8_t*) heap_caps_calloc(_fb2->size, 1, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
         } else {
-            ESP_LOGI(TAG, "Allocating %d KB frame buffer in OnBoard RAM", s_state->fb_size / 1024);
+            ESP_LOGI(TAG, "Allocating %d KB frame buffer in OnBoard RAM", cam->fb_size / 1024);
         }
         if(!_fb2->buf) {
             free(_fb2);
-            ESP_LOGE(TAG, "Allocating %d KB frame buffer Failed", s_state->fb_size / 1024);
+            ESP_LOGE(TAG, "Allocating %d KB frame buffer Failed", cam->fb_size / 1024);
             goto fail;
         }
         memset(_fb2->buf, 0, _fb2->size);
@@ -273,7 +627,7 @@ static esp_err_t camera_fb_init(size_t count)
         _fb1->next = _fb;
     }
 
-    s_state->fb = _fb;//load first buffer
+    cam->fb = _fb;//load first buffer
 
     return ESP_OK;
 
@@ -287,9 +641,77 @@ fail:
     return ESP_ERR_NO_MEM;
 }
 
-static esp_err_t dma_desc_init() {
-    assert(s_state->width % 4 == 0);
-    size_t line_size = s_state->width * s_state->in_bytes_per_pixel * i2s_bytes_per_sample(s_state->sampling_mode);
+// Band mode has no frame buffers. A single frame buffer without memory
+// keeps the frame state, the lines go to band_buf
+static esp_err_t camera_band_init(camera_state_t* cam)
+{
+    camera_fb_int_t * fb = (camera_fb_int_t *) calloc(1, sizeof(camera_fb_int_t));
+    if (!fb) {
+        return ESP_ERR_NO_MEM;
+    }
+    ESP_LOGI(TAG, "Band mode: %u lines, %u bytes", cam->band_lines, cam->band_lines * cam->fb_width * cam->fb_bytes_per_pixel);
+    fb->next = fb;
+    cam->fb = fb;
+    return ESP_OK;
+}
+
+#if CONFIG_CAMERA_JPEG_ADAPTIVE_FB
+static size_t jpeg_fb_target_size(camera_state_t* cam)
+{
+    size_t sizes[JPEG_SIZE_HISTORY];
+    size_t count = cam->jpeg_size_count;
+    memcpy(sizes, cam->jpeg_sizes, sizeof(sizes));
+    //insertion sort, the history is short
+    for (size_t i = 1; i < count; i++) {
+        size_t v = sizes[i];
+        size_t j = i;
+        while (j > 0 && sizes[j - 1] > v) {
+            sizes[j] = sizes[j - 1];
+            j--;
+        }
+        sizes[j] = v;
+    }
+    size_t size = sizes[(count * 95) / 100];
+    size += size / 8;
+    size = (size + JPEG_FB_ALIGN - 1) & ~(JPEG_FB_ALIGN - 1);
+    if (size > cam->fb_size_max) {
+        size = cam->fb_size_max;
+    }
+    return size;
+}
+
+/*
+ * Called from task context for a buffer that is owned by neither the DMA
+ * filter nor the user: a returned buffer, or the only buffer before the
+ * bus is restarted. Keeps the old buffer if the new one can not be had.
+ */
+static void camera_fb_resize(camera_state_t* cam, camera_fb_int_t * fb)
+{
+    if ((cam->config.pixel_format != PIXFORMAT_JPEG && !cam->jpeg_encode) || cam->jpeg_size_count < JPEG_SIZE_HISTORY / 2) {
+        return;
+    }
+    size_t size = jpeg_fb_target_size(cam);
+    cam->fb_size = size;
+    //hysteresis: only grow or shrink by more than an eighth
+    if (size <= fb->size && size + fb->size / 8 >= fb->size) {
+        return;
+    }
+    uint8_t * buf = (uint8_t*) heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!buf) {
+        ESP_LOGD(TAG, "Resizing frame buffer to %u bytes failed", size);
+        return;
+    }
+    ESP_LOGD(TAG, "Frame buffer resized from %u to %u bytes", fb->size, size);
+    *((uint32_t *)buf) = 0;
+    free(fb->buf);
+    fb->buf = buf;
+    fb->size = size;
+}
+#endif
+
+static esp_err_t dma_desc_init(camera_state_t* cam) {
+    assert(cam->width % 4 == 0);
+    size_t line_size = cam->width * cam->in_bytes_per_pixel * i2s_bytes_per_sample(cam->sampling_mode);
     ESP_LOGD(TAG, "Line width (for DMA): %d bytes", line_size);
     size_t dma_per_line = 1;
     size_t buf_size = line_size;
@@ -297,20 +719,49 @@ static esp_err_t dma_desc_init() {
         buf_size /= 2;
         dma_per_line *= 2;
     }
-    size_t dma_desc_count = dma_per_line * 4;
-    s_state->dma_buf_width = line_size;
-    s_state->dma_per_line = dma_per_line;
-    s_state->dma_desc_count = dma_desc_count;
+    // Uncompressed frames have a known number of lines, so the interrupt can be
+    // raised once per group of lines. The group has to divide the frame height
+    // for the last one to end exactly on the frame boundary.
+    size_t batch_lines = 1;
+    if (cam->config.pixel_format != PIXFORMAT_JPEG) {
+        batch_lines = CONFIG_CAMERA_DMA_BATCH_LINES;
+        while (cam->height % batch_lines) {
+            batch_lines--;
+        }
+    }
+    size_t ring_lines = (batch_lines <= 2) ? 4 : batch_lines * 2;
+    if (cam->config.pixel_format == PIXFORMAT_JPEG && cam->sampling_mode == SM_0A0B_0C0D) {
+        // packed JPEG lines take half the memory of high speed mode. Spend it
+        // on a deeper ring, so the filter task can fall further behind
+        ring_lines *= 2;
+    }
+    size_t dma_desc_count = dma_per_line * ring_lines;
+    cam->dma_buf_width = line_size;
+    cam->dma_per_line = dma_per_line;
+    cam->dma_desc_count = dma_desc_count;
+    cam->dma_batch = dma_per_line * batch_lines;
     ESP_LOGD(TAG, "DMA buffer size: %d, DMA buffers per line: %d", buf_size, dma_per_line);
-    ESP_LOGD(TAG, "DMA buffer count: %d", dma_desc_count);
+    ESP_LOGD(TAG, "DMA buffer count: %d, lines per interrupt: %d", dma_desc_count, batch_lines);
     ESP_LOGD(TAG, "DMA buffer total: %d bytes", buf_size * dma_desc_count);
 
-    s_state->dma_buf = (dma_elem_t**) malloc(sizeof(dma_elem_t*) * dma_desc_count);
-    if (s_state->dma_buf == NULL) {
+    cam->dma_buf = (dma_elem_t**) calloc(dma_desc_count, sizeof(dma_elem_t*));
+    if (cam->dma_buf == NULL) {
         return ESP_ERR_NO_MEM;
     }
-    s_state->dma_desc = (lldesc_t*) malloc(sizeof(lldesc_t) * dma_desc_count);
-    if (s_state->dma_desc == NULL) {
+    if (cam->roi) {
+        cam->line_buf = (uint8_t*) heap_caps_malloc(cam->width * cam->fb_bytes_per_pixel, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (cam->line_buf == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    if (cam->band_lines) {
+        cam->band_buf = (uint8_t*) heap_caps_malloc(cam->band_lines * cam->fb_width * cam->fb_bytes_per_pixel, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (cam->band_buf == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    cam->dma_desc = (lldesc_t*) malloc(sizeof(lldesc_t) * dma_desc_count);
+    if (cam->dma_desc == NULL) {
         return ESP_ERR_NO_MEM;
     }
     size_t dma_sample_count = 0;
@@ -320,15 +771,18 @@ static esp_err_t dma_desc_init() {
         if (buf == NULL) {
             return ESP_ERR_NO_MEM;
         }
-        s_state->dma_buf[i] = buf;
+        cam->dma_buf[i] = buf;
         ESP_LOGV(TAG, "dma_buf[%d]=%p", i, buf);
 
-        lldesc_t* pd = &s_state->dma_desc[i];
+        lldesc_t* pd = &cam->dma_desc[i];
         pd->length = buf_size;
-        if (s_state->sampling_mode == SM_0A0B_0B0C && (i + 1) % dma_per_line == 0) {
+        if (cam->sampling_mode == SM_0A0B_0B0C && (i + 1) % dma_per_line == 0) {
             pd->length -= 4;
         }
         dma_sample_count += pd->length / 4;
+        if (i + 1 == cam->dma_batch) {
+            cam->dma_batch_sample_count = dma_sample_count;
+        }
         pd->size = pd->length;
         pd->owner = 1;
         pd->sosf = 1;
@@ -336,40 +790,154 @@ static esp_err_t dma_desc_init() {
         pd->offset = 0;
         pd->empty = 0;
         pd->eof = 1;
-        pd->qe.stqe_next = &s_state->dma_desc[(i + 1) % dma_desc_count];
+        pd->qe.stqe_next = &cam->dma_desc[(i + 1) % dma_desc_count];
+    }
+    cam->dma_sample_count = dma_sample_count;
+    return ESP_OK;
+}
+
+static void dma_desc_deinit(camera_state_t* cam) {
+    if (cam->dma_buf) {
+        for (int i = 0; i < cam->dma_desc_count; ++i) {
+            free(cam->dma_buf[i]);
+        }
+    }
+    free(cam->dma_buf);
+    free(cam->dma_desc);
+    free(cam->line_buf);
+    cam->line_buf = NULL;
+    free(cam->band_buf);
+    cam->band_buf = NULL;
+}
+
+static esp_err_t dma_ring_init(camera_state_t* cam)
+{
+    // room for every descriptor of the DMA ring plus the end of frame markers
+    size_t len = 16;
+    while (len < cam->dma_desc_count * 2) {
+        len *= 2;
+    }
+    dma_ring_t * ring = (dma_ring_t *) heap_caps_calloc(1, sizeof(dma_ring_t) + len * sizeof(size_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (ring == NULL) {
+        return ESP_ERR_NO_MEM;
     }
-    s_state->dma_sample_count = dma_sample_count;
+    ring->mask = len - 1;
+    cam->dma_ready = ring;
+    cam->dma_overruns_reported = 0;
     return ESP_OK;
 }
 
-static void dma_desc_deinit() {
-    if (s_state->dma_buf) {
-        for (int i = 0; i < s_state->dma_desc_count; ++i) {
-            free(s_state->dma_buf[i]);
+static void dma_ring_deinit(camera_state_t* cam)
+{
+    free(cam->dma_ready);
+    cam->dma_ready = NULL;
+}
+
+// ISR side. Returns false if the entry was dropped
+static inline bool IRAM_ATTR dma_ring_push(camera_state_t* cam, size_t item, bool* need_notify)
+{
+    dma_ring_t * ring = cam->dma_ready;
+    size_t head = ring->head;
+    size_t used = head - ring->tail;
+    size_t slots = ring->lost ? 2 : 1;
+    bool desc = item < DMA_RING_DATA_LOST;
+    // DMA is already writing the descriptor after this one. If that is the
+    // oldest one still waiting to be filtered, or the one being filtered right
+    // now (it keeps its entry until dma_ring_release), its data is being overwritten
+    if (used + slots > ring->mask + 1 || (desc && ring->desc_pushed - ring->desc_released + 1 >= cam->dma_desc_count)) {
+        ring->overruns++;
+        ring->lost = true;
+        return false;
+    }
+    if (ring->lost) {
+        ring->items[head & ring->mask] = DMA_RING_DATA_LOST;
+        head++;
+        ring->lost = false;
+    }
+    ring->items[head & ring->mask] = item;
+    if (desc) {
+        ring->desc_pushed++;
+    }
+    // volatile store, the compiler emits a memw so the item is visible before the new head
+    ring->head = head + 1;
+    *need_notify = (used == 0);
+    if (used + slots > ring->max_used) {
+        ring->max_used = used + slots;
+    }
+    return true;
+}
+
+// filter task side, with the bus stopped. Drops everything that is pending
+static inline void IRAM_ATTR dma_ring_flush(camera_state_t* cam)
+{
+    cam->dma_ready->tail = cam->dma_ready->head;
+    cam->dma_ready->desc_released = cam->dma_ready->desc_pushed;
+    cam->dma_ready->lost = false;
+}
+
+// filter task side. Returns false if the ring is empty. The entry stays in
+// the ring, so its DMA buffer counts as in use, until dma_ring_release(pos)
+static inline bool IRAM_ATTR dma_ring_peek(camera_state_t* cam, size_t* item, size_t* pos)
+{
+    dma_ring_t * ring = cam->dma_ready;
+    size_t tail = ring->tail;
+    if (tail == ring->head) {
+        return false;
+    }
+    ring->peek_overruns = ring->overruns;
+    *item = ring->items[tail & ring->mask];
+    *pos = tail;
+    return true;
+}
+
+// filter task side. An overrun since dma_ring_peek() means DMA came round to
+// the oldest buffer, the one that was just filtered: its data may be torn
+static inline bool IRAM_ATTR dma_ring_torn(camera_state_t* cam)
+{
+    return cam->dma_ready->overruns != cam->dma_ready->peek_overruns;
+}
+
+// filter task side. Done with the entry at pos, unless the ring was flushed meanwhile
+static inline void IRAM_ATTR dma_ring_release(camera_state_t* cam, size_t pos)
+{
+    dma_ring_t * ring = cam->dma_ready;
+    if (ring->tail == pos) {
+        if (ring->items[pos & ring->mask] < DMA_RING_DATA_LOST) {
+            ring->desc_released++;
         }
+        ring->tail = pos + 1;
+    }
+}
+
+static void IRAM_ATTR dma_ring_notify(camera_state_t* cam, bool* need_yield)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(cam->dma_filter_task, &higher_priority_task_woken);
+    if (need_yield && !*need_yield) {
+        *need_yield = (higher_priority_task_woken == pdTRUE);
     }
-    free(s_state->dma_buf);
-    free(s_state->dma_desc);
 }
 
-static inline void IRAM_ATTR i2s_conf_reset()
+static inline void IRAM_ATTR i2s_conf_reset(camera_state_t* cam)
 {
     const uint32_t lc_conf_reset_flags = I2S_IN_RST_M | I2S_AHBM_RST_M
                                                                              | I2S_AHBM_FIFO_RST_M;
-    I2S0.lc_conf.val |= lc_conf_reset_flags;
-    I2S0.lc_conf.val &= ~lc_conf_reset_flags;
+    cam->i2s->lc_conf.val |= lc_conf_reset_flags;
+    cam->i2s->lc_conf.val &= ~lc_conf_reset_flags;
 
     const uint32_t conf_reset_flags = I2S_RX_RESET_M | I2S_RX_FIFO_RESET_M
                                                                         | I2S_TX_RESET_M | I2S_TX_FIFO_RESET_M;
-    I2S0.conf.val |= conf_reset_flags;
-    I2S0.conf.val &= ~conf_reset_flags;
-    while (I2S0.state.rx_fifo_reset_back) {
+    cam->i2s->conf.val |= conf_reset_flags;
+    cam->i2s->conf.val &= ~conf_reset_flags;
+    while (cam->i2s->state.rx_fifo_reset_back) {
         ;
     }
 }
 
-static void i2s_init() {
-    camera_config_t* config = &s_state->config;
+static void i2s_init(camera_state_t* cam) {
+#if !CONFIG_CAMERA_SIM_BACKEND
+    camera_config_t* config = &cam->config;
+    const i2s_port_desc_t* port = &s_i2s_ports[config->i2s_port];
 
     // Configure input GPIOs
     gpio_num_t pins[] = {
@@ -399,398 +967,995 @@ static void i2s_init() {
     }
 
     // Route input GPIOs to I2S peripheral using GPIO matrix
-    gpio_matrix_in(config->pin_d0, I2S0I_DATA_IN0_IDX, false);
-    gpio_matrix_in(config->pin_d1, I2S0I_DATA_IN1_IDX, false);
-    gpio_matrix_in(config->pin_d2, I2S0I_DATA_IN2_IDX, false);
-    gpio_matrix_in(config->pin_d3, I2S0I_DATA_IN3_IDX, false);
-    gpio_matrix_in(config->pin_d4, I2S0I_DATA_IN4_IDX, false);
-    gpio_matrix_in(config->pin_d5, I2S0I_DATA_IN5_IDX, false);
-    gpio_matrix_in(config->pin_d6, I2S0I_DATA_IN6_IDX, false);
-    gpio_matrix_in(config->pin_d7, I2S0I_DATA_IN7_IDX, false);
-    gpio_matrix_in(config->pin_vsync, I2S0I_V_SYNC_IDX, false);
-    gpio_matrix_in(0x38, I2S0I_H_SYNC_IDX, false); // HSYNC is set to constant high
-    gpio_matrix_in(config->pin_href, I2S0I_H_ENABLE_IDX, false);
-    gpio_matrix_in(config->pin_pclk, I2S0I_WS_IN_IDX, false);
+    gpio_matrix_in(config->pin_d0, port->sig_data_in0 + 0, false);
+    gpio_matrix_in(config->pin_d1, port->sig_data_in0 + 1, false);
+    gpio_matrix_in(config->pin_d2, port->sig_data_in0 + 2, false);
+    gpio_matrix_in(config->pin_d3, port->sig_data_in0 + 3, false);
+    gpio_matrix_in(config->pin_d4, port->sig_data_in0 + 4, false);
+    gpio_matrix_in(config->pin_d5, port->sig_data_in0 + 5, false);
+    gpio_matrix_in(config->pin_d6, port->sig_data_in0 + 6, false);
+    gpio_matrix_in(config->pin_d7, port->sig_data_in0 + 7, false);
+    gpio_matrix_in(config->pin_vsync, port->sig_v_sync, false);
+    gpio_matrix_in(0x38, port->sig_h_sync, false); // HSYNC is set to constant high
+    gpio_matrix_in(config->pin_href, port->sig_h_enable, false);
+    gpio_matrix_in(config->pin_pclk, port->sig_ws_in, false);
 
     // Enable and configure I2S peripheral
-    periph_module_enable(PERIPH_I2S0_MODULE);
+    periph_module_enable(port->module);
+#endif
     // Toggle some reset bits in LC_CONF register
     // Toggle some reset bits in CONF register
-    i2s_conf_reset();
+    i2s_conf_reset(cam);
     // Enable slave mode (sampling clock is external)
-    I2S0.conf.rx_slave_mod = 1;
+    cam->i2s->conf.rx_slave_mod = 1;
     // Enable parallel mode
-    I2S0.conf2.lcd_en = 1;
+    cam->i2s->conf2.lcd_en = 1;
     // Use HSYNC/VSYNC/HREF to control sampling
-    I2S0.conf2.camera_en = 1;
+    cam->i2s->conf2.camera_en = 1;
     // Configure clock divider
-    I2S0.clkm_conf.clkm_div_a = 1;
-    I2S0.clkm_conf.clkm_div_b = 0;
-    I2S0.clkm_conf.clkm_div_num = 2;
+    cam->i2s->clkm_conf.clkm_div_a = 1;
+    cam->i2s->clkm_conf.clkm_div_b = 0;
+    cam->i2s->clkm_conf.clkm_div_num = 2;
     // FIFO will sink data to DMA
-    I2S0.fifo_conf.dscr_en = 1;
+    cam->i2s->fifo_conf.dscr_en = 1;
     // FIFO configuration
-    I2S0.fifo_conf.rx_fifo_mod = s_state->sampling_mode;
-    I2S0.fifo_conf.rx_fifo_mod_force_en = 1;
-    I2S0.conf_chan.rx_chan_mod = 1;
+    cam->i2s->fifo_conf.rx_fifo_mod = cam->sampling_mode;
+    cam->i2s->fifo_conf.rx_fifo_mod_force_en = 1;
+    cam->i2s->conf_chan.rx_chan_mod = 1;
     // Clear flags which are used in I2S serial mode
-    I2S0.sample_rate_conf.rx_bits_mod = 0;
-    I2S0.conf.rx_right_first = 0;
-    I2S0.conf.rx_msb_right = 0;
-    I2S0.conf.rx_msb_shift = 0;
-    I2S0.conf.rx_mono = 0;
-    I2S0.conf.rx_short_sync = 0;
-    I2S0.timing.val = 0;
-    I2S0.timing.rx_dsync_sw = 1;
-
+    cam->i2s->sample_rate_conf.rx_bits_mod = 0;
+    cam->i2s->conf.rx_right_first = 0;
+    cam->i2s->conf.rx_msb_right = 0;
+    cam->i2s->conf.rx_msb_shift = 0;
+    cam->i2s->conf.rx_mono = 0;
+    cam->i2s->conf.rx_short_sync = 0;
+    cam->i2s->timing.val = 0;
+    cam->i2s->timing.rx_dsync_sw = 1;
+
+#if !CONFIG_CAMERA_SIM_BACKEND
     // Allocate I2S interrupt, keep it disabled
-    esp_intr_alloc(ETS_I2S0_INTR_SOURCE,
+    esp_intr_alloc(port->intr_source,
                                  ESP_INTR_FLAG_INTRDISABLED | ESP_INTR_FLAG_LEVEL1 | ESP_INTR_FLAG_IRAM,
-                                 &i2s_isr, NULL, &s_state->i2s_intr_handle);
+                                 &i2s_isr, cam, &cam->i2s_intr_handle);
+#endif
+}
+
+// Capture keeps running from frame to frame, instead of one frame per esp_camera_fb_get()
+static inline bool IRAM_ATTR camera_streaming(camera_state_t* cam)
+{
+    return cam->config.fb_count > 1 || cam->config.band_cb;
 }
 
-static void IRAM_ATTR i2s_start_bus() {
-    s_state->dma_desc_cur = 0;
-    s_state->dma_received_count = 0;
-    //s_state->dma_filtered_count = 0;
-    esp_intr_disable(s_state->i2s_intr_handle);
-    i2s_conf_reset();
+// Schedule the next captured frame after one that starts now
+static inline void IRAM_ATTR camera_rate_next(camera_state_t* cam, int64_t now)
+{
+    cam->next_frame_time += cam->frame_period;
+    if (cam->next_frame_time < now) {
+        //first frame, or capture fell behind: start a new schedule
+        cam->next_frame_time = now + cam->frame_period;
+    }
+}
 
-    I2S0.rx_eof_num = s_state->dma_sample_count;
-    I2S0.in_link.addr = (uint32_t) &s_state->dma_desc[0];
-    I2S0.in_link.start = 1;
-    I2S0.int_clr.val = I2S0.int_raw.val;
-    I2S0.int_ena.val = 0;
-    I2S0.int_ena.in_done = 1;
+/*
+ * Whether the frame starting at this VSYNC is captured when streaming. A frame
+ * half a sensor period early is taken, so the governor does not drop to half
+ * the rate when the target is a divisor of the sensor frame rate.
+ */
+static inline bool IRAM_ATTR camera_frame_due(camera_state_t* cam, int64_t now)
+{
+    if (!cam->frame_period) {
+        return true;
+    }
+    int64_t sensor_period = now - cam->vsync_time;
+    cam->vsync_time = now;
+    if (now + sensor_period / 2 < cam->next_frame_time) {
+        cam->skipped_frames++;
+        return false;
+    }
+    camera_rate_next(cam, now);
+    return true;
+}
 
-    esp_intr_enable(s_state->i2s_intr_handle);
-    I2S0.conf.rx_start = 1;
-    if (s_state->config.pixel_format == PIXFORMAT_JPEG) {
-        vsync_intr_enable();
+static void IRAM_ATTR i2s_start_bus(camera_state_t* cam) {
+    cam->dma_desc_cur = 0;
+    cam->dma_received_count = 0;
+    cam->frame_start_time = esp_timer_get_time();
+    //cam->dma_filtered_count = 0;
+    i2s_intr_disable(cam);
+    i2s_conf_reset(cam);
+    cam->bus_stopped = false;
+    cam->task_started = true;
+
+    i2s_dma_start(cam, &cam->dma_desc[0]);
+    cam->i2s->int_clr.val = cam->i2s->int_raw.val;
+    cam->i2s->int_ena.val = 0;
+    if (cam->dma_batch > 1) {
+        // interrupt only when a whole group of lines has been received
+        cam->i2s->rx_eof_num = cam->dma_batch_sample_count;
+        cam->i2s->int_ena.in_suc_eof = 1;
+    } else {
+        cam->i2s->rx_eof_num = cam->dma_sample_count;
+        cam->i2s->int_ena.in_done = 1;
     }
+
+    i2s_intr_enable(cam);
+    cam->i2s->conf.rx_start = 1;
+    //continuous capture restarts DMA on every VSYNC, so lines can not drift into the next frame.
+    //A single uncompressed frame ends on its line count first, unless it was started late
+    vsync_intr_enable(cam);
 }
 
-static int i2s_run() {
-    for (int i = 0; i < s_state->dma_desc_count; ++i) {
-        lldesc_t* d = &s_state->dma_desc[i];
+static int i2s_run(camera_state_t* cam) {
+    for (int i = 0; i < cam->dma_desc_count; ++i) {
+        lldesc_t* d = &cam->dma_desc[i];
         ESP_LOGV(TAG, "DMA desc %2d: %u %u %u %u %u %u %p %p",
                          i, d->length, d->size, d->offset, d->eof, d->sosf, d->owner, d->buf, d->qe.stqe_next);
-        memset(s_state->dma_buf[i], 0, d->length);
+        memset(cam->dma_buf[i], 0, d->length);
     }
 
     // wait for frame
-    camera_fb_int_t * fb = s_state->fb;
-    while (s_state->config.fb_count > 1) {
-        while (s_state->fb->ref && s_state->fb->next != fb) {
-            s_state->fb = s_state->fb->next;
+    camera_fb_int_t * fb = cam->fb;
+    while (cam->config.fb_count > 1) {
+        while (cam->fb->ref && cam->fb->next != fb) {
+            cam->fb = cam->fb->next;
         }
-        if (s_state->fb->ref == 0) {
+        if (cam->fb->ref == 0) {
             break;
         }
         vTaskDelay(2);
     }
 
-    //todo: wait for vsync
-    ESP_LOGV(TAG, "Waiting for negative edge on VSYNC");
-
-    int64_t st_t = esp_timer_get_time();
-    while (_gpio_get_level((gpio_num_t)s_state->config.pin_vsync) != 0) {
-        if ((esp_timer_get_time() - st_t) > 1000000LL) {
-            ESP_LOGE(TAG, "Timeout waiting for VSYNC");
-            return -1;
+    //one frame per call: leave the bus idle until the next frame is due
+    if (cam->frame_period && !camera_streaming(cam)) {
+        int64_t wait = cam->next_frame_time - esp_timer_get_time();
+        if (wait >= 1000) {
+            vTaskDelay(pdMS_TO_TICKS(wait / 1000));
         }
     }
+
+    //uncompressed capture counts lines from the start of a frame. With VSYNC
+    //already low the sensor is half way through one, wait for the next
+    bool frame_start = cam->config.pixel_format != PIXFORMAT_JPEG;
+    ESP_LOGV(TAG, "Waiting for negative edge on VSYNC");
+    if ((frame_start || vsync_get_level(cam) != 0) && vsync_wait_edge(cam, pdMS_TO_TICKS(1000)) != ESP_OK) {
+        ESP_LOGE(TAG, "Timeout waiting for VSYNC");
+        return -1;
+    }
     ESP_LOGV(TAG, "Got VSYNC");
-    i2s_start_bus();
+    i2s_start_bus(cam);
+    if (cam->frame_period) {
+        cam->vsync_time = cam->frame_start_time;
+        camera_rate_next(cam, cam->frame_start_time);
+    }
     return 0;
 }
 
-static void IRAM_ATTR i2s_stop_bus()
+static void IRAM_ATTR i2s_stop_bus(camera_state_t* cam)
+{
+    i2s_intr_disable(cam);
+    vsync_intr_disable(cam);
+    i2s_conf_reset(cam);
+    cam->i2s->conf.rx_start = 0;
+    cam->bus_stopped = true;
+}
+
+// Stop the bus from a task. The interrupts may be running on the other core,
+// once this returns none of them queues DMA buffers or restarts DMA until
+// the next i2s_start_bus()
+static void IRAM_ATTR i2s_stop_bus_from_task(camera_state_t* cam)
 {
-    esp_intr_disable(s_state->i2s_intr_handle);
-    vsync_intr_disable();
-    i2s_conf_reset();
-    I2S0.conf.rx_start = 0;
+    portENTER_CRITICAL(&s_i2s_lock[cam->config.i2s_port]);
+    i2s_stop_bus(cam);
+    portEXIT_CRITICAL(&s_i2s_lock[cam->config.i2s_port]);
 }
 
-static void IRAM_ATTR i2s_stop(bool* need_yield)
+static void IRAM_ATTR i2s_stop(camera_state_t* cam, bool partial, bool* need_yield)
 {
-    if (s_state->config.fb_count == 1 && !s_state->fb->bad) {
-        i2s_stop_bus();
+    if (!camera_streaming(cam) || cam->stop_pending) {
+        i2s_stop_bus(cam);
     } else {
-        s_state->dma_received_count = 0;
+        //the next frame follows right after the last line
+        cam->dma_received_count = 0;
+        cam->task_started = false;
+        cam->frame_start_time = esp_timer_get_time();
     }
 
-    size_t val = SIZE_MAX;
-    BaseType_t higher_priority_task_woken;
-    BaseType_t ret = xQueueSendFromISR(s_state->data_ready, &val, &higher_priority_task_woken);
-    if (need_yield && !*need_yield) {
-        *need_yield = (ret == pdTRUE && higher_priority_task_woken == pdTRUE);
+    bool need_notify = false;
+    if (dma_ring_push(cam, partial ? DMA_RING_FRAME_PARTIAL : SIZE_MAX, &need_notify) && need_notify) {
+        dma_ring_notify(cam, need_yield);
     }
 }
 
-static void IRAM_ATTR signal_dma_buf_received(bool* need_yield)
+static void IRAM_ATTR signal_dma_buf_received(camera_state_t* cam, bool* need_yield)
 {
     // ESP_LOGV(TAG, "signal_dma_buf_received");
-    size_t dma_desc_filled = s_state->dma_desc_cur;
-    s_state->dma_desc_cur = (dma_desc_filled + 1) % s_state->dma_desc_count;
-    s_state->dma_received_count++;
-    if (!s_state->fb->ref && s_state->fb->bad) {
-        *need_yield = false;
-        return;
-    }
-    BaseType_t higher_priority_task_woken;
-    BaseType_t ret = xQueueSendFromISR(s_state->data_ready, &dma_desc_filled, &higher_priority_task_woken);
-    if (ret != pdTRUE) {
-        if (!s_state->fb->ref) {
-            s_state->fb->bad = 1;
-        }
-        //ESP_EARLY_LOGW(TAG, "qsf:%d", s_state->dma_received_count);
-        //ets_printf("qsf:%d\n", s_state->dma_received_count);
+    size_t dma_desc_filled = cam->dma_desc_cur;
+    cam->dma_desc_cur = (dma_desc_filled + 1) % cam->dma_desc_count;
+    cam->dma_received_count++;
+    // if the filter task fell behind, the ring marks the frame as missing data
+    bool need_notify = false;
+    if (dma_ring_push(cam, dma_desc_filled, &need_notify) && need_notify) {
+        dma_ring_notify(cam, need_yield);
     }
-    *need_yield = (ret == pdTRUE && higher_priority_task_woken == pdTRUE);
 }
 
 static void IRAM_ATTR i2s_isr(void* arg)
 {
-    I2S0.int_clr.val = I2S0.int_raw.val;
+    camera_state_t* cam = (camera_state_t*) arg;
+    CAMERA_STAGE_START(start);
+    portENTER_CRITICAL_ISR(&s_i2s_lock[cam->config.i2s_port]);
+    cam->i2s->int_clr.val = cam->i2s->int_raw.val;
     bool need_yield = false;
-    signal_dma_buf_received(&need_yield);
-    if (s_state->config.pixel_format != PIXFORMAT_JPEG
-            && s_state->dma_received_count == s_state->height * s_state->dma_per_line) {
-        i2s_stop(&need_yield);
+    if (!cam->bus_stopped) {
+        if (!cam->dma_received_count) {
+            latency_add(&cam->lat_dma, esp_timer_get_time() - cam->frame_start_time);
+        }
+        for (size_t i = 0; i < cam->dma_batch; i++) {
+            signal_dma_buf_received(cam, &need_yield);
+        }
+        if (cam->config.pixel_format != PIXFORMAT_JPEG
+                && cam->dma_received_count == cam->height * cam->dma_per_line) {
+            i2s_stop(cam, false, &need_yield);
+        }
     }
+    portEXIT_CRITICAL_ISR(&s_i2s_lock[cam->config.i2s_port]);
+    CAMERA_STAGE_END(start, cam->isr_time);
     if (need_yield) {
-        portYIELD_FROM_ISR();
+        camera_yield_from_isr();
     }
 }
 
 static void IRAM_ATTR vsync_isr(void* arg) {
+    camera_state_t* cam = (camera_state_t*) arg;
+    CAMERA_STAGE_START(start);
+    portENTER_CRITICAL_ISR(&s_i2s_lock[cam->config.i2s_port]);
     ESP_LOGV(TAG, "vsync_isr");
-    GPIO.status1_w1tc.val = GPIO.status1.val;
-    GPIO.status_w1tc = GPIO.status;
+#if !CONFIG_CAMERA_SIM_BACKEND
+    //clear only our own pin, the VSYNC of another camera may be pending
+    if (cam->config.pin_vsync < 32) {
+        GPIO.status_w1tc = 1UL << cam->config.pin_vsync;
+    } else {
+        GPIO.status1_w1tc.val = 1UL << (cam->config.pin_vsync - 32);
+    }
+#endif
     bool need_yield = false;
-    //if vsync is low and we have received some data, frame is done
-    if (_gpio_get_level((gpio_num_t)s_state->config.pin_vsync) == 0) {
-        if (s_state->dma_received_count > 0) {
-            signal_dma_buf_received(&need_yield);
+    if (cam->ctrl_waiting) {
+        //a frame starts, the control task can write the sensor
+        BaseType_t woken = pdFALSE;
+        cam->ctrl_waiting = false;
+        vTaskNotifyGiveFromISR(cam->ctrl_task, &woken);
+        need_yield = (woken == pdTRUE);
+    }
+    if (cam->vsync_waiting) {
+        //a task waits for the frame boundary, the bus is not running
+        BaseType_t woken = pdFALSE;
+        xSemaphoreGiveFromISR(cam->vsync_sem, &woken);
+        need_yield |= (woken == pdTRUE);
+    } else if (!cam->bus_stopped && vsync_get_level(cam) == 0) {
+        //if vsync is low and we have received some data, frame is done
+        int64_t now = esp_timer_get_time();
+        if (cam->dma_received_count > 0) {
+            bool partial = false;
+            bool stop = cam->dma_filtered_count > 1 || camera_streaming(cam);
+            if (cam->config.pixel_format == PIXFORMAT_JPEG) {
+                signal_dma_buf_received(cam, &need_yield);
+            } else if (cam->task_started) {
+                //uncompressed frames end on the line count. The task started
+                //this one late, its first lines are missing, drop it
+                cam->dma_ready->lost = true;
+                stop = true;
+            } else {
+                //uncompressed frames end on the line count, this one is missing lines
+                partial = true;
+            }
             //ets_printf("end_vsync\n");
-            if (s_state->dma_filtered_count > 1 || s_state->config.fb_count > 1) {
-                i2s_stop(&need_yield);
+            if (stop) {
+                i2s_stop(cam, partial, &need_yield);
             }
         }
-        if (s_state->config.fb_count > 1 || s_state->dma_filtered_count < 2) {
-            I2S0.conf.rx_start = 0;
-            I2S0.in_link.start = 0;
-            I2S0.int_clr.val = I2S0.int_raw.val;
-            i2s_conf_reset();
-            s_state->dma_desc_cur = (s_state->dma_desc_cur + 1) % s_state->dma_desc_count;
-            //I2S0.rx_eof_num = s_state->dma_sample_count;
-            I2S0.in_link.addr = (uint32_t) &s_state->dma_desc[s_state->dma_desc_cur];
-            I2S0.in_link.start = 1;
-            I2S0.conf.rx_start = 1;
-            s_state->dma_received_count = 0;
+        if (cam->stop_pending) {
+            //camera_pause() waits for this frame boundary
+            i2s_stop_bus(cam);
+        } else if (!cam->bus_stopped && (camera_streaming(cam) || cam->dma_filtered_count < 2)) {
+            cam->i2s->conf.rx_start = 0;
+            cam->i2s->in_link.start = 0;
+            cam->i2s->int_clr.val = cam->i2s->int_raw.val;
+            i2s_conf_reset(cam);
+            cam->dma_received_count = 0;
+            cam->task_started = false;
+            //frames that are not due are skipped with the bus idle, the next VSYNC tries again
+            if (!camera_streaming(cam) || camera_frame_due(cam, now)) {
+                cam->dma_desc_cur = (cam->dma_desc_cur + 1) % cam->dma_desc_count;
+                //cam->i2s->rx_eof_num = cam->dma_sample_count;
+                i2s_dma_start(cam, &cam->dma_desc[cam->dma_desc_cur]);
+                cam->i2s->conf.rx_start = 1;
+            }
         }
+        cam->frame_start_time = now;
     }
+    portEXIT_CRITICAL_ISR(&s_i2s_lock[cam->config.i2s_port]);
+    CAMERA_STAGE_END(start, cam->isr_time);
     if (need_yield) {
-        portYIELD_FROM_ISR();
+        camera_yield_from_isr();
+    }
+}
+
+static void IRAM_ATTR camera_fb_queue(camera_state_t* cam, camera_fb_int_t * fb, BaseType_t * taskAwoken)
+{
+    if (xQueueSendFromISR(cam->fb_out, &fb, taskAwoken) == pdTRUE) {
+        latency_add(&cam->lat_done, esp_timer_get_time() - fb->timestamp);
+    } else {
+        cam->queue_send_failures++;
     }
 }
 
-static void IRAM_ATTR camera_fb_done()
+static void IRAM_ATTR camera_fb_done(camera_state_t* cam)
 {
     camera_fb_int_t * fb = NULL, * fb2 = NULL;
     BaseType_t taskAwoken = 0;
 
-    if (s_state->config.fb_count == 1) {
-        xSemaphoreGive(s_state->frame_ready);
+    if (cam->config.fb_count == 1) {
+        xSemaphoreGive(cam->frame_ready);
+        latency_add(&cam->lat_done, esp_timer_get_time() - cam->fb->timestamp);
         return;
     }
 
-    fb = s_state->fb;
-    if (!fb->ref && fb->len) {
+    fb = cam->fb;
+    if (!fb->ref && fb->len && cam->config.grab_mode == CAMERA_GRAB_FIFO
+            && xQueueIsQueueFullFromISR(cam->fb_out) == pdTRUE) {
+        //keep the queued frames in order and drop the new one. Its buffer is refilled
+        fb->len = 0;
+        *((uint32_t *)fb->buf) = 0;
+        cam->frames_dropped++;
+    } else if (!fb->ref && fb->len) {
         //add reference
         fb->ref = 1;
 
         //check if the queue is full
-        if (xQueueIsQueueFullFromISR(s_state->fb_out) == pdTRUE) {
+        if (xQueueIsQueueFullFromISR(cam->fb_out) == pdTRUE) {
             //pop frame buffer from the queue
-            if (xQueueReceiveFromISR(s_state->fb_out, &fb2, &taskAwoken) == pdTRUE) {
-                //free the popped buffer
+            if (xQueueReceiveFromISR(cam->fb_out, &fb2, &taskAwoken) == pdTRUE) {
+                //free the popped buffer, its frame is lost
                 fb2->ref = 0;
                 fb2->len = 0;
+                cam->frames_dropped++;
+                cam->fb_overwrites++;
                 //push the new frame to the end of the queue
-                xQueueSendFromISR(s_state->fb_out, &fb, &taskAwoken);
+                camera_fb_queue(cam, fb, &taskAwoken);
             } else {
                 //queue is full and we could not pop a frame from it
+                cam->queue_send_failures++;
             }
         } else {
             //push the new frame to the end of the queue
-            xQueueSendFromISR(s_state->fb_out, &fb, &taskAwoken);
+            camera_fb_queue(cam, fb, &taskAwoken);
         }
     } else {
         //frame was referenced or empty
     }
 
     //return buffers to be filled
-    while (xQueueReceiveFromISR(s_state->fb_in, &fb2, &taskAwoken) == pdTRUE) {
+    while (xQueueReceiveFromISR(cam->fb_in, &fb2, &taskAwoken) == pdTRUE) {
         fb2->ref = 0;
         fb2->len = 0;
     }
 
     //advance frame buffer only if the current one has data
-    if (s_state->fb->len) {
-        s_state->fb = s_state->fb->next;
+    if (cam->fb->len) {
+        cam->fb = cam->fb->next;
     }
     //try to find the next free frame buffer
-    while (s_state->fb->ref && s_state->fb->next != fb) {
-        s_state->fb = s_state->fb->next;
+    while (cam->fb->ref && cam->fb->next != fb) {
+        cam->fb = cam->fb->next;
     }
     //is the found frame buffer free?
-    if (!s_state->fb->ref) {
+    if (!cam->fb->ref) {
         //buffer found. make sure it's empty
-        s_state->fb->len = 0;
-        *((uint32_t *)s_state->fb->buf) = 0;
+        cam->fb->len = 0;
+        *((uint32_t *)cam->fb->buf) = 0;
     } else {
         //stay at the previous buffer
-        s_state->fb = fb;
+        cam->fb = fb;
     }
 }
 
-static void IRAM_ATTR dma_finish_frame()
+static void IRAM_ATTR jpeg_size_record(camera_state_t* cam, size_t len)
 {
-    size_t buf_len = s_state->width * s_state->fb_bytes_per_pixel / s_state->dma_per_line;
-    //  ESP_LOGV(TAG, "dma_finish_frame()");
-    if (!s_state->fb->ref) {
-        // is the frame bad?
-        if (s_state->fb->bad) {
-            s_state->fb->bad = 0;
-            s_state->fb->len = 0;
-            *((uint32_t *)s_state->fb->buf) = 0;
-            if (s_state->config.fb_count == 1) {
-                i2s_start_bus();
-            }
-        } else {
-            s_state->fb->len = s_state->dma_filtered_count * buf_len;
-            if (s_state->fb->len) {
-                //find the end marker for JPEG. Data after that can be discarded
-                if (s_state->fb->format == PIXFORMAT_JPEG) {
-                    uint8_t * dptr = &s_state->fb->buf[s_state->fb->len - 1];
-                    while (dptr > s_state->fb->buf) {
-                        if (dptr[0] == 0xFF && dptr[1] == 0xD9 && dptr[2] == 0x00 && dptr[3] == 0x00) {
-                            dptr += 2;
-                            s_state->fb->len = dptr - s_state->fb->buf;
-                            if ((s_state->fb->len & 0x1FF) == 0) {
-                                s_state->fb->len += 1;
-                            }
-                            if ((s_state->fb->len % 100) == 0) {
-                                s_state->fb->len += 1;
-                            }
-                            break;
-                        }
-                        dptr--;
-                    }
-                }
-                //send out the frame
-                camera_fb_done();
-            } else if (s_state->config.fb_count == 1) {
-                //frame was empty?
-                i2s_start_bus();
-            }
-        }
-    } else if (s_state->fb->len) {
-        camera_fb_done();
+    cam->jpeg_sizes[cam->jpeg_size_pos] = len;
+    cam->jpeg_size_pos = (cam->jpeg_size_pos + 1) % JPEG_SIZE_HISTORY;
+    if (cam->jpeg_size_count < JPEG_SIZE_HISTORY) {
+        cam->jpeg_size_count++;
     }
-    s_state->dma_filtered_count = 0;
 }
 
-static void IRAM_ATTR dma_filter_buffer(size_t buf_idx)
+static void IRAM_ATTR camera_band_send(camera_state_t* cam, camera_band_event_t event)
 {
-    //no need to process the data if frame is in use or is bad
-    if (s_state->fb->ref || s_state->fb->bad) {
-        return;
-    }
-
-    //check if there is enough space in the frame buffer for the new data
-    size_t buf_len = s_state->width * s_state->fb_bytes_per_pixel / s_state->dma_per_line;
-    size_t fb_pos = s_state->dma_filtered_count * buf_len;
-    if (fb_pos > s_state->fb_size - buf_len) {
-        //size_t processed = s_state->dma_received_count * buf_len;
-        //ets_printf("[%s:%u] ovf pos: %u, processed: %u\n", __FUNCTION__, __LINE__, fb_pos, processed);
-        return;
-    }
-
-    //convert I2S DMA buffer to pixel data
-    (*s_state->dma_filter)(s_state->dma_buf[buf_idx], &s_state->dma_desc[buf_idx], s_state->fb->buf + fb_pos);
+    camera_band_t band = {
+        .event = event,
+        .buf = NULL,
+        .len = 0,
+        .width = cam->fb_width,
+        .y = 0,
+        .lines = cam->out_lines,
+        .height = cam->fb_height,
+        .format = cam->fb_format,
+        .seq = cam->frame_seq,
+        .timestamp = cam->fb->timestamp,
+    };
+    if (event == CAMERA_BAND_DATA) {
+        band.buf = cam->band_buf;
+        band.len = cam->band_fill * cam->fb_width * cam->fb_bytes_per_pixel;
+        band.y = cam->band_next_y - cam->band_fill;
+        band.lines = cam->band_fill;
+        cam->band_fill = 0;
+    }
+    cam->config.band_cb(&band, cam->config.band_cb_arg);
+}
 
-    //first frame buffer
-    if (!s_state->dma_filtered_count) {
-        //check for correct JPEG header
-        if (s_state->sensor.pixformat == PIXFORMAT_JPEG) {
-            uint32_t sig = *((uint32_t *)s_state->fb->buf) & 0xFFFFFF;
-            if (sig != 0xffd8ff) {
-                //ets_printf("bad header\n");
-                s_state->fb->bad = 1;
-                return;
-            }
+// End of frame in band mode: hand out the lines still buffered and close the frame
+static void IRAM_ATTR camera_band_finish(camera_state_t* cam)
+{
+    if (cam->dma_filtered_count) {
+        if (cam->band_fill) {
+            camera_band_send(cam, CAMERA_BAND_DATA);
         }
-        //set the frame properties
-        s_state->fb->width = resolution[s_state->sensor.status.framesize][0];
-        s_state->fb->height = resolution[s_state->sensor.status.framesize][1];
-        s_state->fb->format = s_state->sensor.pixformat;
+        latency_add(&cam->lat_filter, esp_timer_get_time() - cam->fb->timestamp);
+        camera_band_send(cam, CAMERA_BAND_FRAME_END);
+        if (cam->fb->bad || cam->out_lines < cam->fb_height) {
+            cam->frames_dropped++;
+            cam->bad_frames++;
+        }
+        cam->frame_seq++;
     }
-    s_state->dma_filtered_count++;
+    cam->fb->bad = 0;
+    cam->band_fill = 0;
+    cam->band_next_y = 0;
+    cam->dma_filtered_count = 0;
+    cam->out_lines = 0;
 }
 
-static void IRAM_ATTR dma_filter_task(void *pvParameters) {
-    s_state->dma_filtered_count = 0;
-    while (true) {
-        size_t buf_idx;
-             // ESP_LOGV(TAG, "Filter task");
-        if (xQueueReceive(s_state->data_ready, &buf_idx, portMAX_DELAY) == pdTRUE) {
-                     // ESP_LOGV(TAG, "Filter task READY");
-            if (buf_idx == SIZE_MAX) {
-                //this is the end of the frame
-                dma_finish_frame();
-            } else {
-                dma_filter_buffer(buf_idx);
-            }
-        }
+// Map the sensor style quality (0-63, lower is better) to the encoder's 1-100
+static uint8_t camera_jpeg_encode_quality(int qp)
+{
+    if (qp < 0) {
+        qp = 0;
+    } else if (qp > 63) {
+        qp = 63;
     }
+    return 100 - (qp * 99) / 63;
 }
 
-static void IRAM_ATTR dma_filter_jpeg(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst) {
-    size_t end = dma_desc->length / sizeof(dma_elem_t) / 4;
-    // manually unrolling 4 iterations of the loop here
-    for (size_t i = 0; i < end; ++i) {
-        dst[0] = src[0].sample1;
-        dst[1] = src[1].sample1;
-        dst[2] = src[2].sample1;
-        dst[3] = src[3].sample1;
-        src += 4;
-        dst += 4;
+// JPEG encoder output, written straight to the frame buffer
+static size_t camera_jpeg_out(void * arg, size_t index, const void* data, size_t len)
+{
+    camera_state_t* cam = (camera_state_t*) arg;
+    if (!data || cam->fb->bad) {
+        return 0;
+    }
+    if (index + len > cam->fb->size) {
+        //the frame does not fit, ask for half as much again
+        cam->fb->bad = 1;
+        cam->fb_overflows++;
+        jpeg_size_record(cam, cam->fb->size + cam->fb->size / 2);
+        return 0;
     }
+    memcpy(cam->fb->buf + index, data, len);
+    return len;
 }
 
-static void IRAM_ATTR dma_filter_grayscale(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst) {
-    size_t end = dma_desc->length / sizeof(dma_elem_t) / 4;
-    for (size_t i = 0; i < end; ++i) {
-        // manually unrolling 4 iterations of the loop here
-        dst[0] = src[0].sample1;
-        dst[1] = src[1].sample1;
-        dst[2] = src[2].sample1;
-        dst[3] = src[3].sample1;
-        src += 4;
-        dst += 4;
+// Pass the buffered lines on: to the band callback, or to the JPEG encoder
+static void IRAM_ATTR camera_band_flush(camera_state_t* cam)
+{
+    if (cam->config.band_cb) {
+        camera_band_send(cam, CAMERA_BAND_DATA);
+        return;
     }
+    if (cam->jpeg_stream && !jpg_stream_write(cam->jpeg_stream, cam->band_buf, cam->band_fill)) {
+        cam->fb->bad = 1;
+    }
+    cam->band_fill = 0;
 }
 
-static void IRAM_ATTR dma_filter_grayscale_highspeed(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst) {
-    size_t end = dma_desc->length / sizeof(dma_elem_t) / 8;
-    for (size_t i = 0; i < end; ++i) {
-        // manually unrolling 4 iterations of the loop here
-        dst[0] = src[0].sample1;
-        dst[1] = src[2].sample1;
+// End of frame when encoding: complete frames get their length in jpeg_len
+static void IRAM_ATTR camera_jpeg_finish(camera_state_t* cam)
+{
+    if (!cam->jpeg_stream) {
+        return;
+    }
+    if (cam->band_fill && !cam->fb->bad) {
+        camera_band_flush(cam);
+    }
+    if (cam->fb->bad || cam->out_lines < cam->fb_height) {
+        jpg_stream_abort(cam->jpeg_stream);
+    } else {
+        cam->jpeg_len = jpg_stream_end(cam->jpeg_stream);
+    }
+    cam->jpeg_stream = NULL;
+    cam->band_fill = 0;
+}
+
+// Sensor changes written before this frame started show in it, and it will take frame_seq
+static void IRAM_ATTR camera_ctrl_frame(camera_state_t* cam)
+{
+    uint32_t applied = cam->ctrl_applied;
+    if (applied - cam->ctrl_resolved > CTRL_HISTORY) {
+        //no frames for a while, older entries are gone
+        cam->ctrl_resolved = applied - CTRL_HISTORY;
+    }
+    while (cam->ctrl_resolved != applied) {
+        camera_ctrl_status_t * st = &cam->ctrl_history[(cam->ctrl_resolved + 1) & (CTRL_HISTORY - 1)];
+        if (st->applied_time >= cam->fb->timestamp) {
+            break;
+        }
+        st->seq = cam->frame_seq;
+        cam->ctrl_resolved++;
+    }
+}
+
+static void IRAM_ATTR dma_finish_frame(camera_state_t* cam)
+{
+    size_t buf_len = cam->width * cam->fb_bytes_per_pixel / cam->dma_per_line;
+    //  ESP_LOGV(TAG, "dma_finish_frame()");
+    camera_ctrl_frame(cam);
+    if (cam->config.band_cb) {
+        camera_band_finish(cam);
+        return;
+    }
+    camera_jpeg_finish(cam);
+    if (!cam->fb->ref) {
+        if ((cam->sensor.pixformat == PIXFORMAT_JPEG || cam->jpeg_encode) && cam->dma_filtered_count && !cam->jpeg_len) {
+            //no end of image marker, the frame is incomplete
+            cam->fb->bad = 1;
+        }
+        // is the frame bad?
+        if (cam->fb->bad) {
+            cam->frame_seq++;
+            cam->frames_dropped++;
+            cam->bad_frames++;
+            cam->fb->bad = 0;
+            cam->fb->len = 0;
+            *((uint32_t *)cam->fb->buf) = 0;
+            if (cam->config.fb_count == 1) {
+                //esp_camera_fb_get() starts over at the next frame
+                xSemaphoreGive(cam->frame_ready);
+            }
+        } else {
+            if (cam->roi || cam->band_lines) {
+                cam->fb->len = cam->out_lines * cam->fb_width * cam->fb_bytes_per_pixel;
+            } else {
+                cam->fb->len = cam->dma_filtered_count * buf_len;
+            }
+            if (cam->fb->len) {
+                //JPEG ends at the marker found while filtering. Data after that is discarded
+                if (cam->fb->format == PIXFORMAT_JPEG) {
+                    cam->fb->len = cam->jpeg_len;
+                    if ((cam->fb->len & 0x1FF) == 0) {
+                        cam->fb->len += 1;
+                    }
+                    if ((cam->fb->len % 100) == 0) {
+                        cam->fb->len += 1;
+                    }
+                    jpeg_size_record(cam, cam->fb->len);
+                    if (cam->fb->len > cam->jpeg_max_len) {
+                        cam->jpeg_max_len = cam->fb->len;
+                    }
+                }
+                cam->fb->partial = cam->frame_partial;
+                if (cam->frame_partial) {
+                    cam->partial_frames++;
+                }
+                //send out the frame
+                latency_add(&cam->lat_filter, esp_timer_get_time() - cam->fb->timestamp);
+                cam->fb->seq = cam->frame_seq++;
+                camera_fb_done(cam);
+            } else if (cam->config.fb_count == 1) {
+                //frame was empty?
+                xSemaphoreGive(cam->frame_ready);
+            }
+        }
+    } else if (cam->fb->len) {
+        //all buffers are in use, the frame could not be stored
+        cam->frame_seq++;
+        cam->frames_dropped++;
+        camera_fb_done(cam);
+    }
+    cam->dma_filtered_count = 0;
+    cam->out_lines = 0;
+    cam->frame_partial = false;
+    cam->jpeg_len = 0;
+    cam->jpeg_last_ff = false;
+}
+
+// Look for the JPEG end of image marker (FF D9) in freshly filtered data.
+// Returns the offset just past the marker, or 0 if it is not there.
+static size_t IRAM_ATTR jpeg_find_eoi(camera_state_t* cam, const uint8_t * data, size_t len)
+{
+    if (cam->jpeg_last_ff && data[0] == 0xD9) {
+        return 1;
+    }
+    const uint8_t * end = data + len;
+    const uint8_t * p = data;
+    while ((p = (const uint8_t *)memchr(p, 0xFF, end - p)) != NULL && p + 1 < end) {
+        if (p[1] == 0xD9) {
+            return p + 2 - data;
+        }
+        p++;
+    }
+    cam->jpeg_last_ff = (end[-1] == 0xFF);
+    return 0;
+}
+
+// Copy the kept pixels of a filtered line to the frame buffer, one of every
+// roi_step. YUV422 pixels share their chroma in pairs, so each output pixel
+// takes U or V from the pair its source pixel belongs to.
+static void IRAM_ATTR dma_window_copy(camera_state_t* cam, const uint8_t* src, uint8_t* dst)
+{
+    size_t bpp = cam->fb_bytes_per_pixel;
+    size_t step = cam->roi_step;
+    if (step == 1) {
+        memcpy(dst, src, cam->fb_width * bpp);
+    } else if (cam->fb_format == PIXFORMAT_YUV422) {
+        for (size_t x = 0; x < cam->fb_width; ++x) {
+            size_t p = x * step;
+            dst[0] = src[p * 2];//y
+            dst[1] = src[(p & ~1) * 2 + ((x & 1) ? 3 : 1)];//u or v
+            dst += 2;
+        }
+    } else {
+        for (size_t x = 0; x < cam->fb_width; ++x) {
+            for (size_t b = 0; b < bpp; ++b) {
+                dst[b] = src[b];
+            }
+            src += step * bpp;
+            dst += bpp;
+        }
+    }
+}
+
+// Line based filtering, for crop/decimation and band mode. With a crop
+// window or decimation, kept lines are filtered into line_buf and only the
+// kept pixels reach the frame buffer. DMA buffers of lines that are not kept,
+// or that do not overlap the window, are not filtered at all. In band mode the
+// lines are collected in band_buf, which goes to the callback when full.
+// When encoding, each band is an MCU row for the JPEG encoder, whose output
+// is the only thing written to the frame buffer.
+static void IRAM_ATTR dma_filter_lines(camera_state_t* cam, size_t buf_idx)
+{
+    size_t count = cam->dma_filtered_count++;
+    size_t line = count / cam->dma_per_line;
+    size_t part = count % cam->dma_per_line;
+
+    if (!count) {
+        cam->fb->width = cam->fb_width;
+        cam->fb->height = cam->fb_height;
+        cam->fb->format = cam->jpeg_encode ? PIXFORMAT_JPEG : cam->fb_format;
+        cam->fb->timestamp = cam->frame_start_time;
+        if (cam->config.band_cb) {
+            camera_band_send(cam, CAMERA_BAND_FRAME_START);
+        } else if (cam->jpeg_encode) {
+            cam->jpeg_stream = jpg_stream_begin(cam->fb_width, cam->fb_height, cam->fb_format,
+                                                camera_jpeg_encode_quality(cam->config.jpeg_quality),
+                                                &camera_jpeg_out, cam);
+            if (!cam->jpeg_stream) {
+                cam->fb->bad = 1;
+                return;
+            }
+        }
+    }
+    if (line < cam->roi_y || (line - cam->roi_y) % cam->roi_step) {
+        return;
+    }
+    size_t out_line = (line - cam->roi_y) / cam->roi_step;
+    if (out_line >= cam->fb_height) {
+        return;
+    }
+
+    size_t out_len = cam->fb_width * cam->fb_bytes_per_pixel;
+    uint8_t* out;
+    if (cam->band_lines) {
+        out = cam->band_buf + cam->band_fill * out_len;
+    } else {
+        out = cam->fb->buf + out_line * out_len;
+    }
+    size_t part_width = cam->width / cam->dma_per_line;
+    size_t buf_len = part_width * cam->fb_bytes_per_pixel;
+    uint8_t* dst = NULL;
+    if (!cam->roi) {
+        dst = out + part * buf_len;
+    } else {
+        size_t roi_width = (cam->fb_width - 1) * cam->roi_step + 1;
+        if ((part + 1) * part_width > cam->roi_x && part * part_width < cam->roi_x + roi_width) {
+            dst = cam->line_buf + part * buf_len;
+        }
+    }
+    if (dst) {
+        dma_filter_t filter = ((uintptr_t) dst & 3) ? cam->dma_filter_bytes : cam->dma_filter;
+        (*filter)(cam->dma_buf[buf_idx], &cam->dma_desc[buf_idx], dst);
+        if (dma_ring_torn(cam)) {
+            //not passed on, the line is not counted
+            cam->fb->bad = 1;
+            return;
+        }
+    }
+
+    if (part + 1 < cam->dma_per_line) {
+        return;
+    }
+    if (cam->roi) {
+        dma_window_copy(cam, cam->line_buf + cam->roi_x * cam->fb_bytes_per_pixel, out);
+    }
+    cam->out_lines++;
+    if (cam->band_lines) {
+        cam->band_fill++;
+        cam->band_next_y = out_line + 1;
+        if (cam->band_fill == cam->band_lines || cam->band_next_y == cam->fb_height) {
+            camera_band_flush(cam);
+        }
+    }
+}
+
+static void IRAM_ATTR dma_filter_buffer(camera_state_t* cam, size_t buf_idx)
+{
+    //no need to process the data if frame is in use, is bad or the JPEG has already ended
+    if (cam->fb->ref || cam->fb->bad || cam->jpeg_len) {
+        return;
+    }
+
+    if (cam->roi || cam->band_lines) {
+        dma_filter_lines(cam, buf_idx);
+        return;
+    }
+
+    //check if there is enough space in the frame buffer for the new data
+    size_t buf_len = cam->width * cam->fb_bytes_per_pixel / cam->dma_per_line;
+    size_t fb_pos = cam->dma_filtered_count * buf_len;
+    if (fb_pos > cam->fb->size - buf_len) {
+        //the frame does not fit, drop it instead of delivering it truncated
+        cam->fb->bad = 1;
+        if (cam->sensor.pixformat == PIXFORMAT_JPEG) {
+            //the real size is unknown, ask for half as much again
+            cam->fb_overflows++;
+            jpeg_size_record(cam, cam->fb->size + cam->fb->size / 2);
+        }
+        return;
+    }
+
+    //convert I2S DMA buffer to pixel data, word-wide when the destination allows it
+    uint8_t* dst = cam->fb->buf + fb_pos;
+    dma_filter_t filter = ((uintptr_t) dst & 3) ? cam->dma_filter_bytes : cam->dma_filter;
+    (*filter)(cam->dma_buf[buf_idx], &cam->dma_desc[buf_idx], dst);
+    if (dma_ring_torn(cam)) {
+        cam->fb->bad = 1;
+        return;
+    }
+
+    //first frame buffer
+    if (!cam->dma_filtered_count) {
+        //check for correct JPEG header
+        if (cam->sensor.pixformat == PIXFORMAT_JPEG) {
+            uint32_t sig = *((uint32_t *)cam->fb->buf) & 0xFFFFFF;
+            if (sig != 0xffd8ff) {
+                //ets_printf("bad header\n");
+                cam->fb->bad = 1;
+                return;
+            }
+        }
+        //set the frame properties
+        cam->fb->width = cam->fb_width;
+        cam->fb->height = cam->fb_height;
+        cam->fb->format = cam->fb_format;
+        cam->fb->timestamp = cam->frame_start_time;
+    }
+    cam->dma_filtered_count++;
+
+    if (cam->sensor.pixformat == PIXFORMAT_JPEG) {
+        size_t eoi = jpeg_find_eoi(cam, cam->fb->buf + fb_pos, buf_len);
+        if (eoi) {
+            cam->jpeg_len = fb_pos + eoi;
+            if (cam->config.fb_count == 1) {
+                //the frame is complete, no need to wait for VSYNC. Buffers
+                //queued before the bus stopped hold the rest of this frame
+                i2s_stop_bus_from_task(cam);
+                dma_ring_flush(cam);
+                dma_finish_frame(cam);
+            }
+        }
+    }
+}
+
+static void IRAM_ATTR dma_filter_task(void *pvParameters) {
+    camera_state_t* cam = (camera_state_t*) pvParameters;
+    cam->dma_filtered_count = 0;
+    while (true) {
+        size_t buf_idx, pos;
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while (dma_ring_peek(cam, &buf_idx, &pos)) {
+            CAMERA_STAGE_START(start);
+            if (buf_idx == DMA_RING_DATA_LOST) {
+                //descriptors of this frame were overwritten before they were filtered
+                if (!cam->fb->ref) {
+                    cam->fb->bad = 1;
+                }
+            } else if (buf_idx >= DMA_RING_FRAME_PARTIAL) {
+                //this is the end of the frame
+                cam->frame_partial = (buf_idx == DMA_RING_FRAME_PARTIAL);
+                dma_finish_frame(cam);
+                CAMERA_STAGE_END(start, cam->finish_time);
+            } else {
+                dma_filter_buffer(cam, buf_idx);
+                CAMERA_STAGE_END(start, cam->filter_time);
+            }
+            dma_ring_release(cam, pos);
+        }
+        size_t overruns = cam->dma_ready->overruns;
+        if (overruns != cam->dma_overruns_reported) {
+            ESP_LOGW(TAG, "DMA ring overrun: %u descriptors lost", overruns - cam->dma_overruns_reported);
+            cam->dma_overruns_reported = overruns;
+        }
+    }
+}
+
+/*
+ * Word-wide DMA filters
+ *
+ * Every DMA word carries sample1 in bits 16..23 and sample2 in bits 0..7
+ * (see dma_elem_t). These kernels load whole words, assemble four output
+ * bytes in a register and store them with one 32-bit write, so the frame
+ * buffer (usually PSRAM) sees a quarter of the bus transactions of the
+ * byte-wise versions. The destination has to be 4-byte aligned,
+ * dma_filter_buffer uses the *_bytes variants below when it is not.
+ * */
+
+// sample1 of four consecutive words: SM_0A00_0B00, or Y8 in SM_0A0B_0C0D
+static inline uint32_t IRAM_ATTR dma_pack_s1(uint32_t w0, uint32_t w1, uint32_t w2, uint32_t w3)
+{
+    return ((w0 >> 16) & 0x000000FF) | ((w1 >> 8) & 0x0000FF00) | (w2 & 0x00FF0000) | ((w3 << 8) & 0xFF000000);
+}
+
+// sample1 and sample2 of two consecutive words: SM_0A0B_0C0D
+static inline uint32_t IRAM_ATTR dma_pack_s1s2(uint32_t w0, uint32_t w1)
+{
+    return ((w0 >> 16) & 0x000000FF) | ((w0 << 8) & 0x0000FF00) | (w1 & 0x00FF0000) | (w1 << 24);
+}
+
+// SM_0A00_0B00
+static void IRAM_ATTR dma_filter_jpeg(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst)
+{
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 4;
+    uint32_t* out = (uint32_t*) dst;
+    for (size_t i = 0; i < end; ++i) {
+        out[i] = dma_pack_s1(src[0].val, src[1].val, src[2].val, src[3].val);
+        src += 4;
+    }
+}
+
+// SM_0A0B_0C0D: two payload bytes in every DMA word
+static void IRAM_ATTR dma_filter_jpeg_packed(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst)
+{
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 4;
+    uint32_t* out = (uint32_t*) dst;
+    for (size_t i = 0; i < end; ++i) {
+        out[0] = dma_pack_s1s2(src[0].val, src[1].val);
+        out[1] = dma_pack_s1s2(src[2].val, src[3].val);
+        src += 4;
+        out += 2;
+    }
+}
+
+// SM_0A0B_0C0D: keep Y, drop U/V
+static void IRAM_ATTR dma_filter_grayscale(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst)
+{
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 4;
+    uint32_t* out = (uint32_t*) dst;
+    for (size_t i = 0; i < end; ++i) {
+        out[i] = dma_pack_s1(src[0].val, src[1].val, src[2].val, src[3].val);
+        src += 4;
+    }
+}
+
+// SM_0A00_0B00: keep Y, drop U/V
+static void IRAM_ATTR dma_filter_grayscale_highspeed(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst)
+{
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 8;
+    uint32_t* out = (uint32_t*) dst;
+    for (size_t i = 0; i < end; ++i) {
+        out[i] = dma_pack_s1(src[0].val, src[2].val, src[4].val, src[6].val);
+        src += 8;
+    }
+    // the final sample of a line in SM_0A0B_0B0C sampling mode needs special handling
+    if ((dma_desc->length & 0x7) != 0) {
+        dst += end * sizeof(uint32_t);
+        dst[0] = src[0].sample1;
+        dst[1] = src[2].sample1;
+    }
+}
+
+// SM_0A0B_0C0D
+static void IRAM_ATTR dma_filter_yuyv(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst)
+{
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 4;
+    uint32_t* out = (uint32_t*) dst;
+    for (size_t i = 0; i < end; ++i) {
+        out[0] = dma_pack_s1s2(src[0].val, src[1].val);//y0 u y1 v
+        out[1] = dma_pack_s1s2(src[2].val, src[3].val);//y0 u y1 v
+        src += 4;
+        out += 2;
+    }
+}
+
+// SM_0A00_0B00
+static void IRAM_ATTR dma_filter_yuyv_highspeed(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst)
+{
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 8;
+    uint32_t* out = (uint32_t*) dst;
+    for (size_t i = 0; i < end; ++i) {
+        out[0] = dma_pack_s1(src[0].val, src[1].val, src[2].val, src[3].val);//y0 u y1 v
+        out[1] = dma_pack_s1(src[4].val, src[5].val, src[6].val, src[7].val);//y0 u y1 v
+        src += 8;
+        out += 2;
+    }
+    if ((dma_desc->length & 0x7) != 0) {
+        dst = (uint8_t*) out;
+        dst[0] = src[0].sample1;//y0
+        dst[1] = src[1].sample1;//u
+        dst[2] = src[2].sample1;//y1
+        dst[3] = src[2].sample2;//v
+    }
+}
+
+/*
+ * Byte-wise DMA filters, for destinations that are not word aligned
+ * */
+
+static void IRAM_ATTR dma_filter_jpeg_bytes(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst) {
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 4;
+    // manually unrolling 4 iterations of the loop here
+    for (size_t i = 0; i < end; ++i) {
+        dst[0] = src[0].sample1;
+        dst[1] = src[1].sample1;
+        dst[2] = src[2].sample1;
+        dst[3] = src[3].sample1;
+        src += 4;
+        dst += 4;
+    }
+}
+
+static void IRAM_ATTR dma_filter_jpeg_packed_bytes(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst) {
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 4;
+    // manually unrolling 4 iterations of the loop here
+    for (size_t i = 0; i < end; ++i) {
+        dst[0] = src[0].sample1;
+        dst[1] = src[0].sample2;
+        dst[2] = src[1].sample1;
+        dst[3] = src[1].sample2;
+        dst[4] = src[2].sample1;
+        dst[5] = src[2].sample2;
+        dst[6] = src[3].sample1;
+        dst[7] = src[3].sample2;
+        src += 4;
+        dst += 8;
+    }
+}
+
+static void IRAM_ATTR dma_filter_grayscale_bytes(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst) {
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 4;
+    for (size_t i = 0; i < end; ++i) {
+        // manually unrolling 4 iterations of the loop here
+        dst[0] = src[0].sample1;
+        dst[1] = src[1].sample1;
+        dst[2] = src[2].sample1;
+        dst[3] = src[3].sample1;
+        src += 4;
+        dst += 4;
+    }
+}
+
+static void IRAM_ATTR dma_filter_grayscale_highspeed_bytes(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst) {
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 8;
+    for (size_t i = 0; i < end; ++i) {
+        // manually unrolling 4 iterations of the loop here
+        dst[0] = src[0].sample1;
+        dst[1] = src[2].sample1;
         dst[2] = src[4].sample1;
         dst[3] = src[6].sample1;
         src += 8;
@@ -803,7 +1968,7 @@ static void IRAM_ATTR dma_filter_grayscale_highspeed(const dma_elem_t* src, llde
     }
 }
 
-static void IRAM_ATTR dma_filter_yuyv(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst)
+static void IRAM_ATTR dma_filter_yuyv_bytes(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst)
 {
     size_t end = dma_desc->length / sizeof(dma_elem_t) / 4;
     for (size_t i = 0; i < end; ++i) {
@@ -821,7 +1986,7 @@ static void IRAM_ATTR dma_filter_yuyv(const dma_elem_t* src, lldesc_t* dma_desc,
     }
 }
 
-static void IRAM_ATTR dma_filter_yuyv_highspeed(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst)
+static void IRAM_ATTR dma_filter_yuyv_highspeed_bytes(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst)
 {
     size_t end = dma_desc->length / sizeof(dma_elem_t) / 8;
     for (size_t i = 0; i < end; ++i) {
@@ -925,17 +2090,92 @@ static void IRAM_ATTR dma_filter_rgb888_highspeed(const dma_elem_t* src, lldesc_
     }
 }
 
-esp_err_t camera_probe(const camera_config_t* config, camera_model_t* out_camera_model)
+/*
+ * YUV422 conversion filters
+ *
+ * Convert YU/YV pairs while they are still in the internal RAM DMA buffer,
+ * so the frame buffer is written once, in its final format. The byte order
+ * matches what the sensor sends for RGB565 and what fmt2rgb888() produces
+ * for RGB888.
+ * */
+
+static inline void IRAM_ATTR yuyv_to_rgb565(uint8_t y0, uint8_t u, uint8_t y1, uint8_t v, uint8_t* dst)
 {
-    if (s_state != NULL) {
-        return ESP_ERR_INVALID_STATE;
+    uint8_t r, g, b;
+    yuv2rgb(y0, u, v, &r, &g, &b);
+    dst[0] = (r & 0xF8) | (g >> 5);
+    dst[1] = ((g << 3) & 0xE0) | (b >> 3);
+    yuv2rgb(y1, u, v, &r, &g, &b);
+    dst[2] = (r & 0xF8) | (g >> 5);
+    dst[3] = ((g << 3) & 0xE0) | (b >> 3);
+}
+
+static inline void IRAM_ATTR yuyv_to_rgb888(uint8_t y0, uint8_t u, uint8_t y1, uint8_t v, uint8_t* dst)
+{
+    yuv2rgb(y0, u, v, &dst[2], &dst[1], &dst[0]);
+    yuv2rgb(y1, u, v, &dst[5], &dst[4], &dst[3]);
+}
+
+static void IRAM_ATTR dma_filter_yuyv_rgb565(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst)
+{
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 4;
+    for (size_t i = 0; i < end; ++i) {
+        yuyv_to_rgb565(src[0].sample1, src[0].sample2, src[1].sample1, src[1].sample2, &dst[0]);
+        yuyv_to_rgb565(src[2].sample1, src[2].sample2, src[3].sample1, src[3].sample2, &dst[4]);
+        src += 4;
+        dst += 8;
     }
+}
 
-    s_state = (camera_state_t*) heap_caps_calloc(sizeof(*s_state), 1, MALLOC_CAP_SPIRAM);
-    if (!s_state) {
-        return ESP_ERR_NO_MEM;
+static void IRAM_ATTR dma_filter_yuyv_rgb565_highspeed(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst)
+{
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 8;
+    for (size_t i = 0; i < end; ++i) {
+        yuyv_to_rgb565(src[0].sample1, src[1].sample1, src[2].sample1, src[3].sample1, &dst[0]);
+        yuyv_to_rgb565(src[4].sample1, src[5].sample1, src[6].sample1, src[7].sample1, &dst[4]);
+        src += 8;
+        dst += 8;
     }
+    if ((dma_desc->length & 0x7) != 0) {
+        yuyv_to_rgb565(src[0].sample1, src[1].sample1, src[2].sample1, src[2].sample2, &dst[0]);
+    }
+}
 
+static void IRAM_ATTR dma_filter_yuyv_rgb888(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst)
+{
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 4;
+    for (size_t i = 0; i < end; ++i) {
+        yuyv_to_rgb888(src[0].sample1, src[0].sample2, src[1].sample1, src[1].sample2, &dst[0]);
+        yuyv_to_rgb888(src[2].sample1, src[2].sample2, src[3].sample1, src[3].sample2, &dst[6]);
+        src += 4;
+        dst += 12;
+    }
+}
+
+static void IRAM_ATTR dma_filter_yuyv_rgb888_highspeed(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst)
+{
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 8;
+    for (size_t i = 0; i < end; ++i) {
+        yuyv_to_rgb888(src[0].sample1, src[1].sample1, src[2].sample1, src[3].sample1, &dst[0]);
+        yuyv_to_rgb888(src[4].sample1, src[5].sample1, src[6].sample1, src[7].sample1, &dst[6]);
+        src += 8;
+        dst += 12;
+    }
+    if ((dma_desc->length & 0x7) != 0) {
+        yuyv_to_rgb888(src[0].sample1, src[1].sample1, src[2].sample1, src[2].sample2, &dst[0]);
+    }
+}
+
+static esp_err_t camera_probe(camera_state_t* cam, const camera_config_t* config, camera_model_t* out_camera_model)
+{
+#if CONFIG_CAMERA_SIM_BACKEND
+    sim_sensor_init(&cam->sensor);
+    //nothing to probe, the sensor answers at any address
+    cam->sensor.slv_addr = config->sccb_addr;
+    cam->sensor.xclk_freq_hz = config->xclk_freq_hz;
+    *out_camera_model = CAMERA_SIMULATED;
+    return ESP_OK;
+#else
     ESP_LOGD(TAG, "Enabling XCLK output");
     camera_enable_out_clock((camera_config_t*)config);
 
@@ -971,173 +2211,343 @@ esp_err_t camera_probe(const camera_config_t* config, camera_model_t* out_camera
 
     ESP_LOGD(TAG, "Searching for camera address");
     vTaskDelay(10 / portTICK_PERIOD_MS);
-    uint8_t slv_addr = SCCB_Probe();
-    // uint8_t slv_addr = 0x3c;
+    uint8_t slv_addr = config->sccb_addr;
+    if (slv_addr == 0) {
+        slv_addr = SCCB_Probe();
+    }
     if (slv_addr == 0) {
         *out_camera_model = CAMERA_NONE;
-        camera_disable_out_clock();
+        camera_disable_out_clock((camera_config_t*)config);
         ESP_LOGE(TAG, "Camera not detected");
         return ESP_ERR_CAMERA_NOT_DETECTED;
     }
-    s_state->sensor.slv_addr = slv_addr;
-    s_state->sensor.xclk_freq_hz = config->xclk_freq_hz;
+    cam->sensor.slv_addr = slv_addr;
+    cam->sensor.xclk_freq_hz = config->xclk_freq_hz;
 
-    ESP_LOGD(TAG, "Detected camera device at address=0x%02x", s_state->sensor.slv_addr);
-    sensor_id_t* id = &s_state->sensor.id;
+    ESP_LOGD(TAG, "Detected camera device at address=0x%02x", cam->sensor.slv_addr);
+    sensor_id_t* id = &cam->sensor.id;
 
-    if (s_state->sensor.slv_addr == 0x3c) {
-        id->PID = SCCB_Read16(s_state->sensor.slv_addr, REG16_CHIDH);
-        id->VER = SCCB_Read16(s_state->sensor.slv_addr, REG16_CHIDL);
+    if (cam->sensor.slv_addr == 0x3c) {
+        id->PID = SCCB_Read16(cam->sensor.slv_addr, REG16_CHIDH);
+        id->VER = SCCB_Read16(cam->sensor.slv_addr, REG16_CHIDL);
         vTaskDelay(10 / portTICK_PERIOD_MS);
         ESP_LOGD(TAG, "Camera PID=0x%02x VER=0x%02x", id->PID, id->VER);
     }
 
     if (id->PID == OV5640_PID && id->VER == 0x40) {
         *out_camera_model = CAMERA_OV5640;
-        ov5640_init(&s_state->sensor);
+        ov5640_init(&cam->sensor);
     } else if (id->PID == OV5642_PID && id->VER == 0x42) {
         *out_camera_model = CAMERA_OV5642;
-        ov5642_init(&s_state->sensor);
+        ov5642_init(&cam->sensor);
     } else {
         id->PID = 0;
         *out_camera_model = CAMERA_UNKNOWN;
-        camera_disable_out_clock();
+        camera_disable_out_clock((camera_config_t*)config);
         ESP_LOGE(TAG, "Detected camera not supported.");
         return ESP_ERR_CAMERA_NOT_SUPPORTED;
     }
 
     ESP_LOGD(TAG, "Doing SW reset of sensor");
-    s_state->sensor.reset(&s_state->sensor);
+    cam->sensor.reset(&cam->sensor);
+
+    return ESP_OK;
+#endif
+}
+
+// Upper bound of the JPEG compression ratio for a quality setting (0-63, lower is better)
+static int jpeg_compression_bound(int qp)
+{
+    if (qp > 10) {
+        return 16;
+    } else if (qp > 5) {
+        return 10;
+    }
+    return 4;
+}
 
+// Crop window and decimation, see camera_config_t::crop.
+// Expects the frame geometry and format to be set already.
+static esp_err_t camera_window_init(camera_state_t* cam, pixformat_t pix_format)
+{
+    const camera_window_t* crop = &cam->config.crop;
+    size_t x = crop->x;
+    size_t y = crop->y;
+    size_t w = crop->width ? crop->width : cam->width - x;
+    size_t h = crop->height ? crop->height : cam->height - y;
+    size_t step = cam->config.decimation ? cam->config.decimation : 1;
+
+    cam->roi = (x || y || w != cam->width || h != cam->height || step > 1);
+    cam->roi_x = 0;
+    cam->roi_y = 0;
+    cam->roi_step = 1;
+    cam->fb_width = cam->width;
+    cam->fb_height = cam->height;
+    if (!cam->roi) {
+        return ESP_OK;
+    }
+    if (pix_format == PIXFORMAT_JPEG) {
+        ESP_LOGE(TAG, "Crop and decimation are not available for JPEG");
+        cam->roi = false;
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    if (x + w > cam->width || y + h > cam->height || w < step || h < step
+     || (cam->fb_format == PIXFORMAT_YUV422 && ((x | w / step) & 1))) {
+        ESP_LOGE(TAG, "Invalid crop window %ux%u at %u,%u for a %ux%u frame", w, h, x, y, cam->width, cam->height);
+        cam->roi = false;
+        return ESP_ERR_INVALID_ARG;
+    }
+    cam->roi_x = x;
+    cam->roi_y = y;
+    cam->roi_step = step;
+    cam->fb_width = w / step;
+    cam->fb_height = h / step;
+    cam->fb_size = cam->fb_width * cam->fb_height * cam->fb_bytes_per_pixel;
+    ESP_LOGD(TAG, "Crop window %ux%u at %u,%u, decimation %u: %ux%u frame",
+             w, h, x, y, step, cam->fb_width, cam->fb_height);
     return ESP_OK;
 }
 
-// prototype
-esp_err_t esp_camera_deinit();
+// word-wide DMA filter together with its byte-wise fallback
+#define DMA_FILTER_SET(cam, name) do { \
+        (cam)->dma_filter = &dma_filter_##name; \
+        (cam)->dma_filter_bytes = &dma_filter_##name##_bytes; \
+    } while (0)
 
-esp_err_t camera_init(const camera_config_t* config) {
-    if (!s_state) {
-        return ESP_ERR_INVALID_STATE;
-    }
-    if (s_state->sensor.id.PID == 0) {
-        return ESP_ERR_CAMERA_NOT_SUPPORTED;
-    }
-    memcpy(&s_state->config, config, sizeof(*config));
-    esp_err_t err = ESP_OK;
-    framesize_t frame_size = (framesize_t) config->frame_size;
-    pixformat_t pix_format = (pixformat_t) config->pixel_format;
-    s_state->width = resolution[frame_size][0];
-    s_state->height = resolution[frame_size][1];
-
-    if (pix_format == PIXFORMAT_GRAYSCALE) {
-        s_state->fb_size = s_state->width * s_state->height;
-        if (s_state->sensor.id.PID == OV3660_PID) {
-            if (is_hs_mode()) {
-                s_state->sampling_mode = SM_0A00_0B00;
-                s_state->dma_filter = &dma_filter_yuyv_highspeed;
+// Select frame geometry, sampling mode and DMA filter for a format.
+// Expects cam->config.jpeg_quality to be set already.
+static esp_err_t camera_format_init(camera_state_t* cam, pixformat_t pix_format, framesize_t frame_size)
+{
+    cam->width = resolution[frame_size][0];
+    cam->height = resolution[frame_size][1];
+    cam->fb_format = pix_format;
+
+    bool encode = cam->config.convert == CAMERA_CONVERT_JPEG
+            && (pix_format == PIXFORMAT_YUV422 || pix_format == PIXFORMAT_GRAYSCALE);
+
+    if (pix_format == PIXFORMAT_YUV422 && cam->config.convert != CAMERA_CONVERT_NONE && !encode) {
+        bool hs = is_hs_mode(cam);
+        cam->sampling_mode = hs ? SM_0A00_0B00 : SM_0A0B_0C0D;
+        cam->in_bytes_per_pixel = 2;       // camera sends YU/YV
+        switch (cam->config.convert) {
+        case CAMERA_CONVERT_RGB565:
+            cam->fb_format = PIXFORMAT_RGB565;
+            cam->fb_bytes_per_pixel = 2;
+            cam->dma_filter = hs ? &dma_filter_yuyv_rgb565_highspeed : &dma_filter_yuyv_rgb565;
+            cam->dma_filter_bytes = cam->dma_filter;
+            break;
+        case CAMERA_CONVERT_RGB888:
+            cam->fb_format = PIXFORMAT_RGB888;
+            cam->fb_bytes_per_pixel = 3;
+            cam->dma_filter = hs ? &dma_filter_yuyv_rgb888_highspeed : &dma_filter_yuyv_rgb888;
+            cam->dma_filter_bytes = cam->dma_filter;
+            break;
+        case CAMERA_CONVERT_GRAYSCALE:
+            cam->fb_format = PIXFORMAT_GRAYSCALE;
+            cam->fb_bytes_per_pixel = 1;
+            if (hs) {
+                DMA_FILTER_SET(cam, grayscale_highspeed);
             } else {
-                s_state->sampling_mode = SM_0A0B_0C0D;
-                s_state->dma_filter = &dma_filter_yuyv;
+                DMA_FILTER_SET(cam, grayscale);
             }
-            s_state->in_bytes_per_pixel = 1;       // camera sends Y8
+            break;
+        default:
+            ESP_LOGE(TAG, "Requested conversion is not supported");
+            return ESP_ERR_INVALID_ARG;
+        }
+        cam->fb_size = cam->width * cam->height * cam->fb_bytes_per_pixel;
+    } else if (pix_format == PIXFORMAT_GRAYSCALE) {
+        cam->fb_size = cam->width * cam->height;
+        if (cam->sensor.id.PID == OV3660_PID) {
+            if (is_hs_mode(cam)) {
+                cam->sampling_mode = SM_0A00_0B00;
+                DMA_FILTER_SET(cam, yuyv_highspeed);
+            } else {
+                cam->sampling_mode = SM_0A0B_0C0D;
+                DMA_FILTER_SET(cam, yuyv);
+            }
+            cam->in_bytes_per_pixel = 1;       // camera sends Y8
         } else {
-            if (is_hs_mode()) {
-                s_state->sampling_mode = SM_0A00_0B00;
-                s_state->dma_filter = &dma_filter_grayscale_highspeed;
+            if (is_hs_mode(cam)) {
+                cam->sampling_mode = SM_0A00_0B00;
+                DMA_FILTER_SET(cam, grayscale_highspeed);
             } else {
-                s_state->sampling_mode = SM_0A0B_0C0D;
-                s_state->dma_filter = &dma_filter_grayscale;
+                cam->sampling_mode = SM_0A0B_0C0D;
+                DMA_FILTER_SET(cam, grayscale);
             }
-            s_state->in_bytes_per_pixel = 2;       // camera sends YU/YV
+            cam->in_bytes_per_pixel = 2;       // camera sends YU/YV
         }
-        s_state->fb_bytes_per_pixel = 1;       // frame buffer stores Y8
+        cam->fb_bytes_per_pixel = 1;       // frame buffer stores Y8
     } else if (pix_format == PIXFORMAT_YUV422 || pix_format == PIXFORMAT_RGB565) {
-        s_state->fb_size = s_state->width * s_state->height * 2;
-        if (is_hs_mode()) {
-            s_state->sampling_mode = SM_0A00_0B00;
-            s_state->dma_filter = &dma_filter_yuyv_highspeed;
+        cam->fb_size = cam->width * cam->height * 2;
+        if (is_hs_mode(cam)) {
+            cam->sampling_mode = SM_0A00_0B00;
+            DMA_FILTER_SET(cam, yuyv_highspeed);
         } else {
-            s_state->sampling_mode = SM_0A0B_0C0D;
-            s_state->dma_filter = &dma_filter_yuyv;
+            cam->sampling_mode = SM_0A0B_0C0D;
+            DMA_FILTER_SET(cam, yuyv);
         }
-        s_state->in_bytes_per_pixel = 2;       // camera sends YU/YV
-        s_state->fb_bytes_per_pixel = 2;       // frame buffer stores YU/YV/RGB565
+        cam->in_bytes_per_pixel = 2;       // camera sends YU/YV
+        cam->fb_bytes_per_pixel = 2;       // frame buffer stores YU/YV/RGB565
     } else if (pix_format == PIXFORMAT_RGB888) {
-        s_state->fb_size = s_state->width * s_state->height * 3;
-        if (is_hs_mode()) {
-            s_state->sampling_mode = SM_0A00_0B00;
-            s_state->dma_filter = &dma_filter_rgb888_highspeed;
+        cam->fb_size = cam->width * cam->height * 3;
+        if (is_hs_mode(cam)) {
+            cam->sampling_mode = SM_0A00_0B00;
+            cam->dma_filter = &dma_filter_rgb888_highspeed;
+            cam->dma_filter_bytes = &dma_filter_rgb888_highspeed;
         } else {
-            s_state->sampling_mode = SM_0A0B_0C0D;
-            s_state->dma_filter = &dma_filter_rgb888;
+            cam->sampling_mode = SM_0A0B_0C0D;
+            cam->dma_filter = &dma_filter_rgb888;
+            cam->dma_filter_bytes = &dma_filter_rgb888;
         }
-        s_state->in_bytes_per_pixel = 2;       // camera sends RGB565
-        s_state->fb_bytes_per_pixel = 3;       // frame buffer stores RGB888
+        cam->in_bytes_per_pixel = 2;       // camera sends RGB565
+        cam->fb_bytes_per_pixel = 3;       // frame buffer stores RGB888
     } else if (pix_format == PIXFORMAT_JPEG) {
-        if (s_state->sensor.id.PID != OV2640_PID && s_state->sensor.id.PID != OV3660_PID && s_state->sensor.id.PID != OV5642_PID && s_state->sensor.id.PID != OV5640_PID) {
+        if (cam->sensor.id.PID != OV2640_PID && cam->sensor.id.PID != OV3660_PID && cam->sensor.id.PID != OV5642_PID && cam->sensor.id.PID != OV5640_PID) {
             ESP_LOGE(TAG, "JPEG format is only supported for ov2640, ov3660, ov5642 and ov5640");
-            err = ESP_ERR_NOT_SUPPORTED;
-            goto fail;
+            return ESP_ERR_NOT_SUPPORTED;
         }
-        int qp = config->jpeg_quality;
-        int compression_ratio_bound = 1;
-        if (qp > 10) {
-            compression_ratio_bound = 16;
-        } else if (qp > 5) {
-            compression_ratio_bound = 10;
+        cam->in_bytes_per_pixel = 2;
+        cam->fb_bytes_per_pixel = 2;
+        cam->fb_size = (cam->width * cam->height * cam->fb_bytes_per_pixel) / jpeg_compression_bound(cam->config.jpeg_quality);
+        cam->fb_size_max = (cam->width * cam->height * cam->fb_bytes_per_pixel) / 2;
+        if (is_hs_mode(cam)) {
+            cam->sampling_mode = SM_0A00_0B00;
+            DMA_FILTER_SET(cam, jpeg);
         } else {
-            compression_ratio_bound = 4;
-        }
-     (*s_state->sensor.set_quality)(&s_state->sensor, qp);
-        s_state->in_bytes_per_pixel = 2;
-        s_state->fb_bytes_per_pixel = 2;
-        s_state->fb_size = (s_state->width * s_state->height * s_state->fb_bytes_per_pixel) / compression_ratio_bound;
-        s_state->dma_filter = &dma_filter_jpeg;
-        s_state->sampling_mode = SM_0A00_0B00;
+            // two bytes per FIFO word: half the DMA memory and bus traffic
+            cam->sampling_mode = SM_0A0B_0C0D;
+            DMA_FILTER_SET(cam, jpeg_packed);
+        }
     } else {
         ESP_LOGE(TAG, "Requested format is not supported");
-        err = ESP_ERR_NOT_SUPPORTED;
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    esp_err_t err = camera_window_init(cam, pix_format);
+    if (err != ESP_OK) {
+        return err;
+    }
+    cam->band_lines = 0;
+    cam->jpeg_encode = false;
+    if (cam->config.band_cb) {
+        if (pix_format == PIXFORMAT_JPEG || encode) {
+            ESP_LOGE(TAG, "Band mode is not available for JPEG");
+            return ESP_ERR_NOT_SUPPORTED;
+        }
+        //only one band is buffered, in internal RAM
+        cam->band_lines = cam->config.band_lines ? cam->config.band_lines : 1;
+        if (cam->band_lines > cam->fb_height) {
+            cam->band_lines = cam->fb_height;
+        }
+        cam->fb_size = 0;
+    } else if (encode) {
+        //the encoder takes whole MCU rows, the raw frame never reaches the frame buffer
+        cam->jpeg_encode = true;
+        cam->band_lines = (pix_format == PIXFORMAT_GRAYSCALE) ? 8 : 16;
+        size_t raw_size = cam->fb_width * cam->fb_height * cam->fb_bytes_per_pixel;
+        cam->fb_size = raw_size / jpeg_compression_bound(cam->config.jpeg_quality);
+        if (cam->fb_size < JPEG_FB_ALIGN) {
+            cam->fb_size = JPEG_FB_ALIGN;
+        }
+        cam->fb_size_max = raw_size / 2;
+        if (cam->fb_size_max < cam->fb_size) {
+            cam->fb_size_max = cam->fb_size;
+        }
+    }
+    return ESP_OK;
+}
+
+// On failure the caller releases whatever was set up with camera_destroy()
+static esp_err_t camera_init(camera_state_t* cam, const camera_config_t* config) {
+    if (cam->sensor.id.PID == 0) {
+        return ESP_ERR_CAMERA_NOT_SUPPORTED;
+    }
+    memcpy(&cam->config, config, sizeof(*config));
+    if (cam->config.band_cb) {
+        //frames are not kept, see camera_streaming()
+        cam->config.fb_count = 1;
+    }
+#if CONFIG_CAMERA_SIM_BACKEND
+    cam->i2s = sim_bus_init(config->i2s_port, &cam->sensor, &i2s_isr, &vsync_isr, cam);
+    if (!cam->i2s) {
+        return ESP_ERR_NO_MEM;
+    }
+#else
+    cam->i2s = s_i2s_ports[config->i2s_port].dev;
+#endif
+    esp_err_t err = ESP_OK;
+    framesize_t frame_size = (framesize_t) config->frame_size;
+    pixformat_t pix_format = (pixformat_t) config->pixel_format;
+    err = camera_format_init(cam, pix_format, frame_size);
+    if (err != ESP_OK) {
         goto fail;
     }
+    if (pix_format == PIXFORMAT_JPEG) {
+        (*cam->sensor.set_quality)(&cam->sensor, config->jpeg_quality);
+    }
 
     ESP_LOGD(TAG, "in_bpp: %d, fb_bpp: %d, fb_size: %d, mode: %d, width: %d height: %d",
-                     s_state->in_bytes_per_pixel, s_state->fb_bytes_per_pixel,
-                     s_state->fb_size, s_state->sampling_mode,
-                     s_state->width, s_state->height);
+                     cam->in_bytes_per_pixel, cam->fb_bytes_per_pixel,
+                     cam->fb_size, cam->sampling_mode,
+                     cam->width, cam->height);
 
-    i2s_init();
+    i2s_init(cam);
 
-    err = dma_desc_init();
+    err = dma_desc_init(cam);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to initialize I2S and DMA");
         goto fail;
     }
 
-    //s_state->fb_size = 75 * 1024;
-    err = camera_fb_init(s_state->config.fb_count);
+    //cam->fb_size = 75 * 1024;
+    if (cam->config.band_cb) {
+        err = camera_band_init(cam);
+    } else {
+        err = camera_fb_init(cam, cam->config.fb_count);
+    }
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to allocate frame buffer");
         goto fail;
     }
 
-    s_state->data_ready = xQueueCreate(16, sizeof(size_t));
-    if (s_state->data_ready == NULL) {
-        ESP_LOGE(TAG, "Failed to dma queue");
-        err = ESP_ERR_NO_MEM;
+    err = dma_ring_init(cam);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to allocate DMA ring");
         goto fail;
     }
+    //the bus starts with the first esp_camera_fb_get(), or below in band mode
+    cam->bus_stopped = true;
 
-    if (s_state->config.fb_count == 1) {
-        s_state->frame_ready = xSemaphoreCreateBinary();
-        if (s_state->frame_ready == NULL) {
+    cam->vsync_sem = xSemaphoreCreateBinary();
+    if (cam->vsync_sem == NULL) {
+        ESP_LOGE(TAG, "Failed to create semaphore");
+        err = ESP_ERR_NO_MEM;
+        goto fail;
+    }
+    cam->ctrl_queue = xQueueCreate(CTRL_QUEUE_LEN, sizeof(camera_ctrl_t));
+    cam->ctrl_lock = xSemaphoreCreateMutex();
+    if (cam->ctrl_queue == NULL || cam->ctrl_lock == NULL) {
+        ESP_LOGE(TAG, "Failed to create sensor control queue");
+        err = ESP_ERR_NO_MEM;
+        goto fail;
+    }
+    if (cam->config.fb_count == 1) {
+        cam->frame_ready = xSemaphoreCreateBinary();
+        if (cam->frame_ready == NULL) {
             ESP_LOGE(TAG, "Failed to create semaphore");
             err = ESP_ERR_NO_MEM;
             goto fail;
         }
     } else {
-        s_state->fb_in = xQueueCreate(s_state->config.fb_count, sizeof(camera_fb_t *));
-        s_state->fb_out = xQueueCreate(1, sizeof(camera_fb_t *));
-        if (s_state->fb_in == NULL || s_state->fb_out == NULL) {
+        size_t fb_out_len = 1;
+        if (cam->config.grab_mode == CAMERA_GRAB_FIFO) {
+            //one buffer always stays with the DMA filter
+            fb_out_len = cam->config.fb_count - 1;
+        }
+        cam->fb_in = xQueueCreate(cam->config.fb_count, sizeof(camera_fb_t *));
+        cam->fb_out = xQueueCreate(fb_out_len, sizeof(camera_fb_t *));
+        if (cam->fb_in == NULL || cam->fb_out == NULL) {
             ESP_LOGE(TAG, "Failed to fb queues");
             err = ESP_ERR_NO_MEM;
             goto fail;
@@ -1145,65 +2555,203 @@ esp_err_t camera_init(const camera_config_t* config) {
     }
     //ToDo: core affinity?
 #if CONFIG_CAMERA_CORE0
-    if (!xTaskCreatePinnedToCore(&dma_filter_task, "dma_filter", 4096, NULL, 10, &s_state->dma_filter_task, 0))
+    if (!xTaskCreatePinnedToCore(&dma_filter_task, "dma_filter", 4096, cam, 10, &cam->dma_filter_task, 0))
 #elif CONFIG_CAMERA_CORE1
-    if (!xTaskCreatePinnedToCore(&dma_filter_task, "dma_filter", 4096, NULL, 10, &s_state->dma_filter_task, 1))
+    if (!xTaskCreatePinnedToCore(&dma_filter_task, "dma_filter", 4096, cam, 10, &cam->dma_filter_task, 1))
 #else
-    if (!xTaskCreate(&dma_filter_task, "dma_filter", 4096, NULL, 10, &s_state->dma_filter_task))
+    if (!xTaskCreate(&dma_filter_task, "dma_filter", 4096, cam, 10, &cam->dma_filter_task))
 #endif
     {
         ESP_LOGE(TAG, "Failed to create DMA filter task");
         err = ESP_ERR_NO_MEM;
         goto fail;
     }
+    //the sensor setters log and go through SCCB and the register cache
+    if (!xTaskCreate(&camera_ctrl_task, "camera_ctrl", 4096, cam, 5, &cam->ctrl_task)) {
+        ESP_LOGE(TAG, "Failed to create sensor control task");
+        err = ESP_ERR_NO_MEM;
+        goto fail;
+    }
 
-    vsync_intr_disable();
+    vsync_intr_disable(cam);
+#if !CONFIG_CAMERA_SIM_BACKEND
     gpio_install_isr_service(ESP_INTR_FLAG_LEVEL1 | ESP_INTR_FLAG_IRAM);
-    err = gpio_isr_handler_add((gpio_num_t)s_state->config.pin_vsync, &vsync_isr, NULL);
+    err = gpio_isr_handler_add((gpio_num_t)cam->config.pin_vsync, &vsync_isr, cam);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "vsync_isr_handler_add failed (%x)", err);
         goto fail;
     }
+#endif
 
-    s_state->sensor.status.framesize = frame_size;
-    s_state->sensor.pixformat = pix_format;
-     // ESP_LOGD(TAG, "Setting frame size to %dx%d", s_state->width, s_state->height);
-     // if (s_state->sensor.set_framesize(&s_state->sensor, frame_size) != 0) {
+    cam->sensor.status.framesize = frame_size;
+    cam->sensor.pixformat = pix_format;
+     // ESP_LOGD(TAG, "Setting frame size to %dx%d", cam->width, cam->height);
+     // if (cam->sensor.set_framesize(&cam->sensor, frame_size) != 0) {
      //   ESP_LOGE(TAG, "Failed to set frame size");
      //   err = ESP_ERR_CAMERA_FAILED_TO_SET_FRAME_SIZE;
      //   goto fail;
      // }
-     // s_state->sensor.set_pixformat(&s_state->sensor, pix_format);
+     // cam->sensor.set_pixformat(&cam->sensor, pix_format);
 
-    if (s_state->sensor.id.PID == OV2640_PID) {
-        s_state->sensor.set_gainceiling(&s_state->sensor, GAINCEILING_2X);
-        s_state->sensor.set_bpc(&s_state->sensor, false);
-        s_state->sensor.set_wpc(&s_state->sensor, true);
-        s_state->sensor.set_lenc(&s_state->sensor, true);
+    if (cam->sensor.id.PID == OV2640_PID) {
+        cam->sensor.set_gainceiling(&cam->sensor, GAINCEILING_2X);
+        cam->sensor.set_bpc(&cam->sensor, false);
+        cam->sensor.set_wpc(&cam->sensor, true);
+        cam->sensor.set_lenc(&cam->sensor, true);
     }
 
-    if (skip_frame()) {
+    if (skip_frame(cam)) {
         err = ESP_ERR_CAMERA_FAILED_TO_SET_OUT_FORMAT;
         goto fail;
     }
     //todo: for some reason the first set of the quality does not work.
     if (pix_format == PIXFORMAT_JPEG) {
-        (*s_state->sensor.set_quality)(&s_state->sensor, config->jpeg_quality);
+        (*cam->sensor.set_quality)(&cam->sensor, config->jpeg_quality);
+    }
+    cam->sensor.init_status(&cam->sensor);
+    err = camera_rate_init(cam);
+    if (err != ESP_OK) {
+        goto fail;
+    }
+    if (cam->config.band_cb && i2s_run(cam) != 0) {
+        err = ESP_ERR_TIMEOUT;
+        goto fail;
     }
-    s_state->sensor.init_status(&s_state->sensor);
     return ESP_OK;
 
-    SCCB_Deinit();
-
 fail:
-    esp_camera_deinit();
     return err;
 }
 
-esp_err_t esp_camera_init(const camera_config_t* config)
+/*
+ * Applies queued sensor changes right after VSYNC, so they do not land in the
+ * middle of a frame being captured. Everything queued when the frame starts
+ * goes out together. When no capture is running there is nothing to tear and
+ * the changes are written at once.
+ */
+static void camera_ctrl_task(void *pvParameters)
+{
+    camera_state_t* cam = (camera_state_t*) pvParameters;
+    camera_ctrl_t ctrl;
+    while (true) {
+        xQueuePeek(cam->ctrl_queue, &ctrl, portMAX_DELAY);
+        if (!cam->bus_stopped) {
+            ulTaskNotifyTake(pdTRUE, 0);
+            cam->ctrl_waiting = true;
+            //the timeout covers a bus that stops before the next VSYNC
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CTRL_WAIT_MS));
+            cam->ctrl_waiting = false;
+        }
+        //the batch goes out in one go, with no other sensor traffic in between
+        xSemaphoreTake(s_sensor_lock, portMAX_DELAY);
+        UBaseType_t count = uxQueueMessagesWaiting(cam->ctrl_queue);
+        uint32_t last = cam->ctrl_applied;
+        while (count-- && xQueueReceive(cam->ctrl_queue, &ctrl, 0) == pdTRUE) {
+            camera_ctrl_status_t * st = &cam->ctrl_history[ctrl.ticket & (CTRL_HISTORY - 1)];
+            st->ticket = ctrl.ticket;
+            st->result = ctrl.setter(&cam->sensor, ctrl.value);
+            st->applied_time = INT64_MAX;
+            last = ctrl.ticket;
+        }
+        //frames started from now on show the whole batch
+        int64_t now = esp_timer_get_time();
+        for (uint32_t t = cam->ctrl_applied + 1; t - 1 != last; t++) {
+            cam->ctrl_history[t & (CTRL_HISTORY - 1)].applied_time = now;
+        }
+        cam->ctrl_applied = last;
+        xSemaphoreGive(s_sensor_lock);
+    }
+}
+
+static void camera_destroy(camera_state_t* cam)
+{
+    //the control task is not stopped in the middle of a batch, and the
+    //register cache goes away while no other camera uses it
+    xSemaphoreTake(s_sensor_lock, portMAX_DELAY);
+    if (cam->ctrl_task) {
+        vTaskDelete(cam->ctrl_task);
+    }
+    if (cam->ctrl_queue) {
+        vQueueDelete(cam->ctrl_queue);
+    }
+    if (cam->ctrl_lock) {
+        vSemaphoreDelete(cam->ctrl_lock);
+    }
+    if (cam->dma_filter_task) {
+        vTaskDelete(cam->dma_filter_task);
+    }
+    if (cam->fb_in) {
+        vQueueDelete(cam->fb_in);
+    }
+    if (cam->fb_out) {
+        vQueueDelete(cam->fb_out);
+    }
+    if (cam->frame_ready) {
+        vSemaphoreDelete(cam->frame_ready);
+    }
+    if (cam->vsync_sem) {
+        vSemaphoreDelete(cam->vsync_sem);
+    }
+#if CONFIG_CAMERA_SIM_BACKEND
+    if (cam->i2s) {
+        sim_bus_deinit(cam->config.i2s_port);
+    }
+#else
+    if (cam->i2s) {
+        gpio_isr_handler_remove((gpio_num_t)cam->config.pin_vsync);
+    }
+    if (cam->i2s_intr_handle) {
+        esp_intr_disable(cam->i2s_intr_handle);
+        esp_intr_free(cam->i2s_intr_handle);
+    }
+#endif
+    dma_desc_deinit(cam);
+    dma_ring_deinit(cam);
+    camera_fb_deinit(cam);
+    reg_cache_deinit(cam->sensor.slv_addr);
+#if !CONFIG_CAMERA_SIM_BACKEND
+    camera_disable_out_clock(&cam->config);
+    if (cam->i2s) {
+        periph_module_disable(s_i2s_ports[cam->config.i2s_port].module);
+    }
+#endif
+    if (s_i2s_owner[cam->config.i2s_port] == cam) {
+        s_i2s_owner[cam->config.i2s_port] = NULL;
+    }
+    xSemaphoreGive(s_sensor_lock);
+    free(cam);
+}
+
+esp_err_t esp_camera_handle_init(const camera_config_t* config, esp_camera_handle_t* out_handle)
 {
+    if (config == NULL || out_handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (config->i2s_port < 0 || config->i2s_port >= I2S_PORT_COUNT) {
+        ESP_LOGE(TAG, "Invalid I2S port %d", config->i2s_port);
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_i2s_owner[config->i2s_port]) {
+        ESP_LOGE(TAG, "I2S%d is already used by another camera", config->i2s_port);
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (s_sensor_lock == NULL) {
+        s_sensor_lock = xSemaphoreCreateMutex();
+        if (s_sensor_lock == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    camera_state_t* cam = (camera_state_t*) heap_caps_calloc(sizeof(*cam), 1, MALLOC_CAP_SPIRAM);
+    if (!cam) {
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(&cam->config, config, sizeof(*config));
+    s_i2s_owner[config->i2s_port] = cam;
+
+    xSemaphoreTake(s_sensor_lock, portMAX_DELAY);
     camera_model_t camera_model = CAMERA_NONE;
-    esp_err_t err = camera_probe(config, &camera_model);
+    esp_err_t err = camera_probe(cam, config, &camera_model);
 
     if (camera_model == CAMERA_OV7725) {
         ESP_LOGD(TAG, "Detected OV7725 camera");
@@ -1220,103 +2768,429 @@ esp_err_t esp_camera_init(const camera_config_t* config)
         ESP_LOGD(TAG, "Detected OV5642 camera");
     } else if (camera_model == CAMERA_OV5640) {
         ESP_LOGD(TAG, "Detected OV5640 camera");
+    } else if (camera_model == CAMERA_SIMULATED) {
+        ESP_LOGI(TAG, "Using simulated camera");
     } else {
         ESP_LOGE(TAG, "Camera not supported");
         err = ESP_ERR_CAMERA_NOT_SUPPORTED;
         goto fail;
     }
-    err = camera_init(config);
+    err = camera_init(cam, config);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Camera init failed with error 0x%x", err);
         goto fail;
     }
+    xSemaphoreGive(s_sensor_lock);
+    *out_handle = cam;
     return ESP_OK;
 
 fail:
-    free(s_state);
-    s_state = NULL;
-    camera_disable_out_clock();
+    xSemaphoreGive(s_sensor_lock);
+    camera_destroy(cam);
     return err;
 }
 
-esp_err_t esp_camera_deinit()
+esp_err_t esp_camera_handle_deinit(esp_camera_handle_t handle)
 {
-    if (s_state == NULL) {
+    if (handle == NULL) {
         return ESP_ERR_INVALID_STATE;
     }
-    if (s_state->dma_filter_task) {
-        vTaskDelete(s_state->dma_filter_task);
-    }
-    if (s_state->data_ready) {
-        vQueueDelete(s_state->data_ready);
-    }
-    if (s_state->fb_in) {
-        vQueueDelete(s_state->fb_in);
-    }
-    if (s_state->fb_out) {
-        vQueueDelete(s_state->fb_out);
-    }
-    if (s_state->frame_ready) {
-        vSemaphoreDelete(s_state->frame_ready);
-    }
-    gpio_isr_handler_remove((gpio_num_t)s_state->config.pin_vsync);
-    if (s_state->i2s_intr_handle) {
-        esp_intr_disable(s_state->i2s_intr_handle);
-        esp_intr_free(s_state->i2s_intr_handle);
-    }
-    dma_desc_deinit();
-    camera_fb_deinit();
-    free(s_state);
-    s_state = NULL;
-    camera_disable_out_clock();
-    periph_module_disable(PERIPH_I2S0_MODULE);
+    camera_destroy(handle);
     return ESP_OK;
 }
 
-camera_fb_t* esp_camera_fb_get()
+camera_fb_t* esp_camera_handle_fb_get(esp_camera_handle_t handle)
 {
     ESP_LOGV(TAG, "esp_camera_fb_get");
-    if (s_state == NULL) {
+    camera_state_t* cam = handle;
+    if (cam == NULL) {
+        return NULL;
+    }
+    if (cam->config.band_cb) {
+        ESP_LOGE(TAG, "No frame buffers in band mode");
         return NULL;
     }
-    if (!I2S0.conf.rx_start) {
-        if (s_state->config.fb_count > 1) {
+    //rx_start is also low while the frame-rate governor skips frames
+    if (cam->bus_stopped) {
+        if (cam->config.fb_count > 1) {
             ESP_LOGD(TAG, "i2s_run");
         }
-        if (i2s_run() != 0) {
+#if CONFIG_CAMERA_JPEG_ADAPTIVE_FB
+        else {
+            //the previous frame is implicitly returned
+            camera_fb_resize(cam, cam->fb);
+        }
+#endif
+        if (i2s_run(cam) != 0) {
             return NULL;
         }
     }
-    if(s_state->config.fb_count == 1) {
+    if(cam->config.fb_count == 1) {
         ESP_LOGV(TAG, "xSemaphoreTake");
-        xSemaphoreTake(s_state->frame_ready, ( TickType_t ) s_state->config.fb_get_timeout * 1000);
-    }
-    if(s_state->config.fb_count == 1) {
-        ESP_LOGV(TAG, "return");
-        return (camera_fb_t*)s_state->fb;
+        TickType_t timeout = ( TickType_t ) cam->config.fb_get_timeout * 1000;
+        TickType_t start = xTaskGetTickCount();
+        //a dropped frame leaves the buffer empty and the bus stopped. Restarting
+        //from here waits for VSYNC, so the next frame is not taken up half way
+        while (xSemaphoreTake(cam->frame_ready, timeout) == pdTRUE && !cam->fb->len) {
+            TickType_t waited = xTaskGetTickCount() - start;
+            if (waited >= timeout || i2s_run(cam) != 0) {
+                break;
+            }
+            timeout -= waited;
+            start += waited;
+        }
     }
     camera_fb_int_t * fb = NULL;
-    if(s_state->fb_out) {
+    if(cam->config.fb_count == 1) {
+        ESP_LOGV(TAG, "return");
+        fb = cam->fb;
+    } else if(cam->fb_out) {
         ESP_LOGV(TAG, "xQueueReceive");
-        if (xQueueReceive(s_state->fb_out, &fb, ( TickType_t ) s_state->config.fb_get_timeout * 1000) == pdFALSE) {
+        if (xQueueReceive(cam->fb_out, &fb, ( TickType_t ) cam->config.fb_get_timeout * 1000) == pdFALSE) {
             return NULL;
         }
     }
+    if (fb) {
+        portENTER_CRITICAL(&s_i2s_lock[cam->config.i2s_port]);
+        //a single buffer taken before was implicitly returned by this call
+        cam->fb_held = (cam->config.fb_count == 1) ? 1 : cam->fb_held + 1;
+        portEXIT_CRITICAL(&s_i2s_lock[cam->config.i2s_port]);
+        latency_add(&cam->lat_get, esp_timer_get_time() - fb->timestamp);
+        uint32_t dropped = cam->frames_dropped;
+        fb->dropped = dropped - cam->frames_dropped_reported;
+        cam->frames_dropped_reported = dropped;
+    }
     return (camera_fb_t*)fb;
 }
 
-void esp_camera_fb_return(camera_fb_t * fb)
+void esp_camera_handle_fb_return(esp_camera_handle_t handle, camera_fb_t * fb)
 {
-    if(fb == NULL || s_state == NULL || s_state->config.fb_count == 1 || s_state->fb_in == NULL) {
+    camera_state_t* cam = handle;
+    if(fb == NULL || cam == NULL) {
+        return;
+    }
+    if (cam->config.fb_count == 1) {
+        //nothing to queue, the single buffer is refilled by the next esp_camera_fb_get()
+        portENTER_CRITICAL(&s_i2s_lock[cam->config.i2s_port]);
+        cam->fb_held = 0;
+        portEXIT_CRITICAL(&s_i2s_lock[cam->config.i2s_port]);
+        return;
+    }
+    if (cam->fb_in == NULL) {
         return;
     }
-    xQueueSend(s_state->fb_in, &fb, portMAX_DELAY);
+#if CONFIG_CAMERA_JPEG_ADAPTIVE_FB
+    //still referenced, so the DMA filter will not touch it
+    camera_fb_resize(cam, (camera_fb_int_t *)fb);
+#endif
+    portENTER_CRITICAL(&s_i2s_lock[cam->config.i2s_port]);
+    cam->fb_held--;
+    portEXIT_CRITICAL(&s_i2s_lock[cam->config.i2s_port]);
+    xQueueSend(cam->fb_in, &fb, portMAX_DELAY);
 }
 
-sensor_t * esp_camera_sensor_get()
+/*
+ * Stop the bus at the end of the frame being captured and wait for the filter
+ * task to go idle. Queued frames are reclaimed. Fails without touching the
+ * capture if the application still holds a frame buffer.
+ */
+static esp_err_t camera_pause(camera_state_t* cam)
+{
+    if (cam->fb_held) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    //the interrupts stop the bus at the end of the line count or at VSYNC
+    cam->stop_pending = true;
+    int64_t start = esp_timer_get_time();
+    while (!cam->bus_stopped && esp_timer_get_time() - start < 1000000LL) {
+        vTaskDelay(1);
+    }
+    //no frame boundary within a second, or a restart in the meantime
+    i2s_stop_bus_from_task(cam);
+    while (cam->dma_ready->head != cam->dma_ready->tail
+            || eTaskGetState(cam->dma_filter_task) != eBlocked) {
+        vTaskDelay(1);
+    }
+    cam->stop_pending = false;
+
+    camera_fb_int_t * fb = NULL;
+    if (cam->config.fb_count == 1) {
+        xSemaphoreTake(cam->frame_ready, 0);
+    } else {
+        while (xQueueReceive(cam->fb_out, &fb, 0) == pdTRUE) {
+            fb->ref = 0;
+        }
+        while (xQueueReceive(cam->fb_in, &fb, 0) == pdTRUE) {
+            fb->ref = 0;
+        }
+    }
+
+    fb = cam->fb;
+    do {
+        fb->len = 0;
+        fb->bad = 0;
+        fb = fb->next;
+    } while (fb && fb != cam->fb);
+
+    if (cam->jpeg_stream) {
+        jpg_stream_abort(cam->jpeg_stream);
+        cam->jpeg_stream = NULL;
+    }
+    cam->dma_filtered_count = 0;
+    cam->out_lines = 0;
+    cam->band_fill = 0;
+    cam->jpeg_len = 0;
+    cam->jpeg_last_ff = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_camera_handle_reconfigure(esp_camera_handle_t handle, framesize_t framesize, pixformat_t pixformat, int quality)
+{
+    camera_state_t* cam = handle;
+    if (cam == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (framesize >= FRAMESIZE_INVALID) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = camera_pause(cam);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Return all frame buffers before reconfiguring");
+        return err;
+    }
+
+    size_t old_desc_count = cam->dma_desc_count;
+    pixformat_t old_format = cam->config.pixel_format;
+    framesize_t old_size = cam->config.frame_size;
+
+    cam->config.jpeg_quality = quality;
+    err = camera_format_init(cam, pixformat, framesize);
+    if (err != ESP_OK) {
+        //restore the previous geometry, nothing was reallocated yet
+        cam->config.jpeg_quality = cam->sensor.status.quality;
+        camera_format_init(cam, old_format, old_size);
+        //band mode goes on streaming with the previous settings
+        if (cam->config.band_cb && i2s_run(cam) != 0) {
+            return ESP_ERR_TIMEOUT;
+        }
+        return err;
+    }
+    cam->config.pixel_format = pixformat;
+    cam->config.frame_size = framesize;
+
+    //DMA buffers depend on the line size and the number of lines per interrupt
+    if (pixformat != old_format || framesize != old_size) {
+        dma_desc_deinit(cam);
+        cam->dma_buf = NULL;
+        cam->dma_desc = NULL;
+        err = dma_desc_init(cam);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to initialize DMA");
+            return err;
+        }
+        if (cam->dma_desc_count != old_desc_count) {
+            dma_ring_deinit(cam);
+            err = dma_ring_init(cam);
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "Failed to allocate DMA ring");
+                return err;
+            }
+        }
+    }
+    cam->i2s->fifo_conf.rx_fifo_mod = cam->sampling_mode;
+
+    //reuse the frame buffers that are large enough
+    cam->jpeg_size_count = 0;
+    cam->jpeg_size_pos = 0;
+    camera_fb_int_t * fb = cam->fb;
+    do {
+        if (fb->size < cam->fb_size) {
+            free(fb->buf);
+            fb->buf = (uint8_t*) heap_caps_malloc(cam->fb_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+            if (!fb->buf) {
+                fb->size = 0;
+                ESP_LOGE(TAG, "Allocating %d KB frame buffer Failed", cam->fb_size / 1024);
+                return ESP_ERR_NO_MEM;
+            }
+            fb->size = cam->fb_size;
+        }
+        if (fb->buf) {
+            *((uint32_t *)fb->buf) = 0;
+        }
+        fb = fb->next;
+    } while (fb && fb != cam->fb);
+
+    //waits for a batch of the control task to finish
+    xSemaphoreTake(s_sensor_lock, portMAX_DELAY);
+    if (pixformat != old_format && cam->sensor.set_pixformat(&cam->sensor, pixformat) != 0) {
+        err = ESP_ERR_CAMERA_FAILED_TO_SET_OUT_FORMAT;
+    } else if (cam->sensor.set_framesize(&cam->sensor, framesize) != 0) {
+        err = ESP_ERR_CAMERA_FAILED_TO_SET_FRAME_SIZE;
+    } else {
+        if (pixformat == PIXFORMAT_JPEG) {
+            cam->sensor.set_quality(&cam->sensor, quality);
+        }
+        cam->sensor.status.framesize = framesize;
+        cam->sensor.pixformat = pixformat;
+        err = camera_rate_init(cam);
+    }
+    xSemaphoreGive(s_sensor_lock);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    //capture resumes with the next esp_camera_fb_get(), band mode streams on its own
+    if (cam->config.band_cb && i2s_run(cam) != 0) {
+        return ESP_ERR_TIMEOUT;
+    }
+    return ESP_OK;
+}
+
+sensor_t * esp_camera_handle_sensor_get(esp_camera_handle_t handle)
 {
-    if (s_state == NULL) {
+    if (handle == NULL) {
         return NULL;
     }
-    return &s_state->sensor;
+    return &handle->sensor;
+}
+
+esp_err_t esp_camera_handle_get_stats(esp_camera_handle_t handle, camera_stats_t * stats)
+{
+    camera_state_t* cam = handle;
+    if (cam == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    stats->frames = cam->frame_seq;
+    stats->dropped = cam->frames_dropped;
+    stats->fb_overflows = cam->fb_overflows;
+    stats->jpeg_max_len = cam->jpeg_max_len;
+    stats->fb_size = cam->fb_size;
+    stats->dma_ring_overruns = cam->dma_ready->overruns;
+    stats->dma_ring_max_depth = cam->dma_ready->max_used;
+    stats->fb_queued = cam->fb_out ? uxQueueMessagesWaiting(cam->fb_out) : 0;
+    stats->isr_time_us = cam->isr_time;
+    stats->filter_time_us = cam->filter_time;
+    stats->finish_time_us = cam->finish_time;
+    stats->bad_frames = cam->bad_frames;
+    stats->queue_send_failures = cam->queue_send_failures;
+    stats->fb_overwrites = cam->fb_overwrites;
+    stats->partial_frames = cam->partial_frames;
+    stats->skipped_frames = cam->skipped_frames;
+    latency_read(&cam->lat_dma, &stats->latency_dma);
+    latency_read(&cam->lat_filter, &stats->latency_filter);
+    latency_read(&cam->lat_done, &stats->latency_done);
+    latency_read(&cam->lat_get, &stats->latency_get);
+    return ESP_OK;
+}
+
+esp_err_t esp_camera_handle_control(esp_camera_handle_t handle, camera_setter_t setter, int value, uint32_t * ticket)
+{
+    camera_state_t* cam = handle;
+    if (cam == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (setter == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    //the DMA buffers and frame buffers depend on these, see esp_camera_reconfigure()
+    if (setter == (camera_setter_t) cam->sensor.set_framesize || setter == (camera_setter_t) cam->sensor.set_pixformat) {
+        ESP_LOGE(TAG, "Change the frame size and pixel format with esp_camera_reconfigure()");
+        return ESP_ERR_INVALID_ARG;
+    }
+    camera_ctrl_t ctrl = {
+        .setter = setter,
+        .value = value,
+    };
+    esp_err_t err = ESP_OK;
+    xSemaphoreTake(cam->ctrl_lock, portMAX_DELAY);
+    ctrl.ticket = cam->ctrl_next_ticket + 1;
+    if (xQueueSend(cam->ctrl_queue, &ctrl, 0) == pdTRUE) {
+        cam->ctrl_next_ticket = ctrl.ticket;
+    } else {
+        err = ESP_ERR_NO_MEM;
+    }
+    xSemaphoreGive(cam->ctrl_lock);
+    if (err == ESP_OK && ticket) {
+        *ticket = ctrl.ticket;
+    }
+    return err;
+}
+
+esp_err_t esp_camera_handle_control_status(esp_camera_handle_t handle, uint32_t ticket, uint32_t * first_seq)
+{
+    camera_state_t* cam = handle;
+    if (cam == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (ticket == 0 || ticket > cam->ctrl_next_ticket) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (ticket > cam->ctrl_resolved) {
+        return ESP_ERR_CAMERA_PENDING;
+    }
+    camera_ctrl_status_t st = cam->ctrl_history[ticket & (CTRL_HISTORY - 1)];
+    if (st.ticket != ticket) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (st.result != 0) {
+        return ESP_FAIL;
+    }
+    if (first_seq) {
+        *first_seq = st.seq;
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_camera_init(const camera_config_t* config)
+{
+    if (s_state != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return esp_camera_handle_init(config, &s_state);
+}
+
+esp_err_t esp_camera_deinit()
+{
+    esp_err_t err = esp_camera_handle_deinit(s_state);
+    s_state = NULL;
+    return err;
+}
+
+camera_fb_t* esp_camera_fb_get()
+{
+    return esp_camera_handle_fb_get(s_state);
+}
+
+void esp_camera_fb_return(camera_fb_t * fb)
+{
+    esp_camera_handle_fb_return(s_state, fb);
+}
+
+esp_err_t esp_camera_reconfigure(framesize_t framesize, pixformat_t pixformat, int quality)
+{
+    return esp_camera_handle_reconfigure(s_state, framesize, pixformat, quality);
+}
+
+sensor_t * esp_camera_sensor_get()
+{
+    return esp_camera_handle_sensor_get(s_state);
+}
+
+esp_err_t esp_camera_get_stats(camera_stats_t * stats)
+{
+    return esp_camera_handle_get_stats(s_state, stats);
+}
+
+esp_err_t esp_camera_control(camera_setter_t setter, int value, uint32_t * ticket)
+{
+    return esp_camera_handle_control(s_state, setter, value, ticket);
+}
+
+esp_err_t esp_camera_control_status(uint32_t ticket, uint32_t * first_seq)
+{
+    return esp_camera_handle_control_status(s_state, ticket, first_seq);
 }
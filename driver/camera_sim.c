@@ -0,0 +1,421 @@
+// Copyright 2015-2016 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "sdkconfig.h"
+
+#if CONFIG_CAMERA_SIM_BACKEND
+
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "camera_common.h"
+#include "camera_sim_bus.h"
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
+#include "esp32-hal-log.h"
+#define TAG ""
+#else
+#include "esp_log.h"
+static const char* TAG = "camera_sim";
+#endif
+
+#ifndef CONFIG_CAMERA_SIM_PCLK_HZ
+#define CONFIG_CAMERA_SIM_PCLK_HZ 10000000
+#endif
+
+#define SIM_PORT_COUNT      2
+#define SIM_VSYNC_LINES     8       // lines of vertical blanking with VSYNC high
+#define SIM_PORCH_LINES     8       // lines of vertical blanking after VSYNC falls
+
+typedef struct {
+    i2s_dev_t regs;                 // stands in for the I2S register block
+    sensor_t* sensor;
+    camera_sim_isr_t i2s_isr;
+    camera_sim_isr_t vsync_isr;
+    void* arg;
+
+    TaskHandle_t task;
+    volatile bool running;
+    volatile bool i2s_intr_en;
+    volatile bool vsync_intr_en;
+    volatile int vsync_level;
+
+    lldesc_t* volatile desc;        // descriptor being filled
+    volatile size_t desc_pos;       // bytes of it already written
+    size_t eof_words;               // words received since the last in_suc_eof
+
+    uint8_t* line;
+    size_t line_size;
+
+    uint32_t pclk_hz;
+    const uint8_t* stream;
+    size_t stream_len;
+    size_t stream_pos;
+
+    uint32_t frames;
+    uint64_t bytes;
+    int64_t start_time;
+} sim_port_t;
+
+static sim_port_t s_sim[SIM_PORT_COUNT] = {
+    { .pclk_hz = CONFIG_CAMERA_SIM_PCLK_HZ },
+    { .pclk_hz = CONFIG_CAMERA_SIM_PCLK_HZ },
+};
+
+static void sim_desc_done(sim_port_t* sim)
+{
+    lldesc_t* d = sim->desc;
+    sim->desc = d->qe.stqe_next;
+    sim->desc_pos = 0;
+    sim->eof_words += d->length / sizeof(dma_elem_t);
+
+    bool fire = false;
+    if (sim->regs.int_ena.in_done) {
+        sim->regs.int_raw.in_done = 1;
+        fire = true;
+    }
+    if (sim->regs.int_ena.in_suc_eof && sim->eof_words >= sim->regs.rx_eof_num) {
+        sim->regs.int_raw.in_suc_eof = 1;
+        sim->eof_words = 0;
+        fire = true;
+    }
+    if (fire && sim->i2s_intr_en) {
+        sim->i2s_isr(sim->arg);
+    }
+}
+
+// Write sensor bytes to the DMA descriptors the way the FIFO packs them
+static void sim_dma_write(sim_port_t* sim, const uint8_t* data, size_t len)
+{
+    size_t i = 0;
+    while (i < len) {
+        lldesc_t* d = sim->desc;
+        if (!d || !sim->regs.conf.rx_start) {
+            return;
+        }
+        dma_elem_t* w = (dma_elem_t*) (d->buf + sim->desc_pos);
+        switch (sim->regs.fifo_conf.rx_fifo_mod) {
+        case SM_0A0B_0C0D:
+            w->sample1 = data[i];
+            w->sample2 = (i + 1 < len) ? data[i + 1] : 0;
+            i += 2;
+            break;
+        case SM_0A0B_0B0C:
+            //every byte is sent twice, the last word of a line has no successor
+            if (i + 1 >= len) {
+                return;
+            }
+            w->sample1 = data[i];
+            w->sample2 = data[i + 1];
+            i += 1;
+            break;
+        default:
+            w->sample1 = data[i];
+            w->sample2 = 0;
+            i += 1;
+            break;
+        }
+        sim->desc_pos += sizeof(dma_elem_t);
+        if (sim->desc_pos >= d->length) {
+            sim_desc_done(sim);
+        }
+    }
+}
+
+static size_t sim_jpeg_len(sim_port_t* sim)
+{
+    if (sim->stream) {
+        return sim->stream_len;
+    }
+    //vary the size a little to exercise the frame buffer handling
+    size_t width = resolution[sim->sensor->status.framesize][0];
+    size_t height = resolution[sim->sensor->status.framesize][1];
+    size_t base = width * height / 10;
+    return base + (sim->frames % 8) * base / 16;
+}
+
+static void sim_fill_line(sim_port_t* sim, size_t frame_pos, size_t frame_len)
+{
+    uint8_t* line = sim->line;
+    if (sim->sensor->pixformat == PIXFORMAT_JPEG) {
+        for (size_t i = 0; i < sim->line_size; i++, frame_pos++) {
+            if (frame_pos >= frame_len) {
+                line[i] = 0;
+            } else if (sim->stream) {
+                line[i] = sim->stream[frame_pos];
+            } else if (frame_pos < 4) {
+                static const uint8_t soi[] = { 0xFF, 0xD8, 0xFF, 0xE0 };
+                line[i] = soi[frame_pos];
+            } else if (frame_pos >= frame_len - 2) {
+                line[i] = (frame_pos == frame_len - 2) ? 0xFF : 0xD9;
+            } else {
+                line[i] = (frame_pos + sim->frames) % 0xFF;
+            }
+        }
+    } else if (sim->stream) {
+        for (size_t i = 0; i < sim->line_size; i++) {
+            line[i] = sim->stream[sim->stream_pos];
+            sim->stream_pos = (sim->stream_pos + 1) % sim->stream_len;
+        }
+    } else {
+        for (size_t i = 0; i < sim->line_size; i++, frame_pos++) {
+            line[i] = (frame_pos + sim->frames) & 0xFF;
+        }
+    }
+}
+
+static void sim_wait(sim_port_t* sim, int64_t* deadline, size_t bytes)
+{
+    if (!sim->pclk_hz) {
+        return;
+    }
+    *deadline += (int64_t) bytes * 1000000LL / sim->pclk_hz;
+    int64_t ahead = *deadline - esp_timer_get_time();
+    if (ahead < -1000000LL) {
+        //too far behind to catch up, do not burst
+        *deadline -= ahead;
+    } else if (ahead >= portTICK_PERIOD_MS * 1000) {
+        vTaskDelay(ahead / (portTICK_PERIOD_MS * 1000));
+    }
+}
+
+static void sim_vsync(sim_port_t* sim, int level)
+{
+    bool edge = sim->vsync_level && !level;
+    sim->vsync_level = level;
+    if (edge && sim->vsync_intr_en) {
+        sim->vsync_isr(sim->arg);
+    }
+}
+
+static void sim_task(void* arg)
+{
+    sim_port_t* sim = (sim_port_t*) arg;
+    int64_t deadline = esp_timer_get_time();
+    sim->start_time = deadline;
+
+    while (sim->running) {
+        framesize_t framesize = sim->sensor->status.framesize;
+        size_t width = resolution[framesize][0];
+        size_t height = resolution[framesize][1];
+        //the simulated sensor always sends two bytes per pixel
+        size_t line_size = width * 2;
+        if (line_size > sim->line_size) {
+            free(sim->line);
+            sim->line = (uint8_t*) malloc(line_size);
+            if (!sim->line) {
+                ESP_LOGE(TAG, "Failed to allocate line buffer");
+                sim->line_size = 0;
+                vTaskDelay(100 / portTICK_PERIOD_MS);
+                continue;
+            }
+        }
+        sim->line_size = line_size;
+
+        size_t frame_len = line_size * height;
+        size_t lines = height;
+        if (sim->sensor->pixformat == PIXFORMAT_JPEG) {
+            frame_len = sim_jpeg_len(sim);
+            lines = (frame_len + line_size - 1) / line_size;
+        }
+
+        sim_vsync(sim, 1);
+        sim_wait(sim, &deadline, line_size * SIM_VSYNC_LINES);
+        sim_vsync(sim, 0);
+        //the back porch gives the driver time to start DMA after the edge
+        sim_wait(sim, &deadline, line_size * SIM_PORCH_LINES);
+
+        for (size_t y = 0; y < lines && sim->running; y++) {
+            sim_fill_line(sim, y * line_size, frame_len);
+            sim_dma_write(sim, sim->line, line_size);
+            sim->bytes += line_size;
+            sim_wait(sim, &deadline, line_size);
+        }
+        sim->frames++;
+    }
+
+    free(sim->line);
+    sim->line = NULL;
+    sim->line_size = 0;
+    sim->task = NULL;
+    vTaskDelete(NULL);
+}
+
+i2s_dev_t* sim_bus_init(int i2s_port, sensor_t* sensor, camera_sim_isr_t i2s_isr, camera_sim_isr_t vsync_isr, void* arg)
+{
+    sim_port_t* sim = &s_sim[i2s_port];
+    memset((void*) &sim->regs, 0, sizeof(sim->regs));
+    sim->sensor = sensor;
+    sim->i2s_isr = i2s_isr;
+    sim->vsync_isr = vsync_isr;
+    sim->arg = arg;
+    sim->i2s_intr_en = false;
+    sim->vsync_intr_en = false;
+    sim->vsync_level = 1;
+    sim->desc = NULL;
+    sim->frames = 0;
+    sim->bytes = 0;
+    sim->running = true;
+    if (!xTaskCreate(&sim_task, "camera_sim", 2048, sim, 9, &sim->task)) {
+        ESP_LOGE(TAG, "Failed to create simulation task");
+        sim->running = false;
+        return NULL;
+    }
+    ESP_LOGI(TAG, "Simulated camera bus on I2S%d, PCLK %u Hz", i2s_port, sim->pclk_hz);
+    return &sim->regs;
+}
+
+void sim_bus_deinit(int i2s_port)
+{
+    sim_port_t* sim = &s_sim[i2s_port];
+    sim->running = false;
+    sim->i2s_intr_en = false;
+    sim->vsync_intr_en = false;
+    while (sim->task) {
+        vTaskDelay(1);
+    }
+}
+
+void sim_bus_dma_start(int i2s_port, lldesc_t* desc)
+{
+    sim_port_t* sim = &s_sim[i2s_port];
+    sim->desc_pos = 0;
+    sim->eof_words = 0;
+    sim->desc = desc;
+}
+
+void sim_bus_i2s_intr_enable(int i2s_port, bool enable)
+{
+    s_sim[i2s_port].i2s_intr_en = enable;
+}
+
+void sim_bus_vsync_intr_enable(int i2s_port, bool enable)
+{
+    s_sim[i2s_port].vsync_intr_en = enable;
+}
+
+int sim_bus_vsync_level(int i2s_port)
+{
+    return s_sim[i2s_port].vsync_level;
+}
+
+esp_err_t camera_sim_set_pclk(int i2s_port, uint32_t pclk_hz)
+{
+    if (i2s_port < 0 || i2s_port >= SIM_PORT_COUNT) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_sim[i2s_port].pclk_hz = pclk_hz;
+    return ESP_OK;
+}
+
+esp_err_t camera_sim_set_stream(int i2s_port, const uint8_t* data, size_t len)
+{
+    if (i2s_port < 0 || i2s_port >= SIM_PORT_COUNT || (data && !len)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    sim_port_t* sim = &s_sim[i2s_port];
+    sim->stream = NULL;
+    sim->stream_len = len;
+    sim->stream_pos = 0;
+    sim->stream = data;
+    return ESP_OK;
+}
+
+esp_err_t camera_sim_get_info(int i2s_port, camera_sim_info_t* info)
+{
+    if (i2s_port < 0 || i2s_port >= SIM_PORT_COUNT || !info) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    sim_port_t* sim = &s_sim[i2s_port];
+    info->frames = sim->frames;
+    info->bytes = sim->bytes;
+    info->elapsed_us = sim->task ? esp_timer_get_time() - sim->start_time : 0;
+    return ESP_OK;
+}
+
+/*
+ * Simulated sensor. It reports itself as an OV2640 so that every format is
+ * accepted, and only records the settings the bus needs.
+ */
+static int sim_sensor_noop(sensor_t* sensor)
+{
+    return 0;
+}
+
+static int sim_sensor_set_int(sensor_t* sensor, int value)
+{
+    return 0;
+}
+
+static int sim_sensor_set_pixformat(sensor_t* sensor, pixformat_t pixformat)
+{
+    sensor->pixformat = pixformat;
+    return 0;
+}
+
+static int sim_sensor_set_framesize(sensor_t* sensor, framesize_t framesize)
+{
+    sensor->status.framesize = framesize;
+    return 0;
+}
+
+static int sim_sensor_set_quality(sensor_t* sensor, int quality)
+{
+    sensor->status.quality = quality;
+    return 0;
+}
+
+static int sim_sensor_set_gainceiling(sensor_t* sensor, gainceiling_t gainceiling)
+{
+    return 0;
+}
+
+void sim_sensor_init(sensor_t* sensor)
+{
+    sensor->id.PID = OV2640_PID;
+    sensor->slv_addr = 0;
+
+    sensor->init_status = sim_sensor_noop;
+    sensor->reset = sim_sensor_noop;
+    sensor->set_pixformat = sim_sensor_set_pixformat;
+    sensor->set_framesize = sim_sensor_set_framesize;
+    sensor->set_contrast = sim_sensor_set_int;
+    sensor->set_brightness = sim_sensor_set_int;
+    sensor->set_saturation = sim_sensor_set_int;
+    sensor->set_sharpness = sim_sensor_set_int;
+    sensor->set_denoise = sim_sensor_set_int;
+    sensor->set_gainceiling = sim_sensor_set_gainceiling;
+    sensor->set_quality = sim_sensor_set_quality;
+    sensor->set_colorbar = sim_sensor_set_int;
+    sensor->set_whitebal = sim_sensor_set_int;
+    sensor->set_gain_ctrl = sim_sensor_set_int;
+    sensor->set_exposure_ctrl = sim_sensor_set_int;
+    sensor->set_hmirror = sim_sensor_set_int;
+    sensor->set_vflip = sim_sensor_set_int;
+    sensor->set_aec2 = sim_sensor_set_int;
+    sensor->set_awb_gain = sim_sensor_set_int;
+    sensor->set_agc_gain = sim_sensor_set_int;
+    sensor->set_aec_value = sim_sensor_set_int;
+    sensor->set_special_effect = sim_sensor_set_int;
+    sensor->set_wb_mode = sim_sensor_set_int;
+    sensor->set_ae_level = sim_sensor_set_int;
+    sensor->set_dcw = sim_sensor_set_int;
+    sensor->set_bpc = sim_sensor_set_int;
+    sensor->set_wpc = sim_sensor_set_int;
+    sensor->set_raw_gma = sim_sensor_set_int;
+    sensor->set_lenc = sim_sensor_set_int;
+}
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Simulated camera bus, enabled with CONFIG_CAMERA_SIM_BACKEND.
+ *
+ * The I2S peripheral, its DMA and the VSYNC line are replaced by a task per
+ * I2S port that streams sensor bytes into the driver's DMA descriptors at a
+ * given pixel clock and calls the driver's interrupt handlers. Everything
+ * above the bus (DMA filters, frame pool, queues) runs unchanged, so its
+ * throughput and CPU time can be measured without a sensor attached.
+ *
+ * Settings are per I2S port and can be changed before or after the camera
+ * on that port is initialized.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Counters of a simulated bus
+ */
+typedef struct {
+    uint32_t frames;            /*!< Frames sent by the simulated sensor */
+    uint64_t bytes;             /*!< Bytes sent by the simulated sensor */
+    int64_t elapsed_us;         /*!< Time since the bus was started, in microseconds */
+} camera_sim_info_t;
+
+/**
+ * @brief Set the pixel clock of the simulated sensor, one byte is sent per clock
+ *
+ * @param i2s_port  I2S port of the camera
+ * @param pclk_hz   Pixel clock in Hz, 0 to send as fast as possible
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG for a bad port
+ */
+esp_err_t camera_sim_set_pclk(int i2s_port, uint32_t pclk_hz);
+
+/**
+ * @brief Replay recorded sensor data instead of the built in test pattern
+ *
+ * For JPEG every frame is a copy of the data, which should hold one image.
+ * For other formats the data is sent in a loop as raw pixels. The data must
+ * stay valid while the bus runs.
+ *
+ * @param i2s_port  I2S port of the camera
+ * @param data      Bytes as output by the sensor, NULL for the test pattern
+ * @param len       Length of the data
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG for a bad port
+ */
+esp_err_t camera_sim_set_stream(int i2s_port, const uint8_t* data, size_t len);
+
+/**
+ * @brief Read the counters of a simulated bus
+ *
+ * @param i2s_port  I2S port of the camera
+ * @param info      Structure to fill
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG for a bad port
+ */
+esp_err_t camera_sim_get_info(int i2s_port, camera_sim_info_t* info);
+
+#ifdef __cplusplus
+}
+#endif
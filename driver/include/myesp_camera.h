@@ -73,6 +73,69 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Frame delivery policy used when 2 or more frame buffers are allocated
+ */
+typedef enum {
+    CAMERA_GRAB_LATEST,         /*!< Only the newest frame is queued. An unclaimed older frame is recycled */
+    CAMERA_GRAB_FIFO,           /*!< Up to fb_count - 1 frames are queued in order. New frames are dropped while the queue is full */
+} camera_grab_mode_t;
+
+/**
+ * @brief Conversion done by the driver while capturing YUV422 frames
+ *
+ * With CAMERA_CONVERT_JPEG the quality comes from jpeg_quality. Only a few
+ * lines of the raw frame are held at a time, in internal RAM.
+ */
+typedef enum {
+    CAMERA_CONVERT_NONE = 0,        /*!< Frame buffer holds the data as sent by the sensor */
+    CAMERA_CONVERT_RGB565,          /*!< Frame buffer holds RGB565, in the byte order the sensor uses */
+    CAMERA_CONVERT_RGB888,          /*!< Frame buffer holds RGB888, in the byte order of fmt2rgb888() */
+    CAMERA_CONVERT_GRAYSCALE,       /*!< Frame buffer holds Y8 */
+    CAMERA_CONVERT_JPEG,            /*!< Frame buffer holds JPEG, compressed in software while capturing. Also available for GRAYSCALE */
+} camera_convert_t;
+
+/**
+ * @brief Part of the frame kept in the frame buffer, in pixels of the selected frame size
+ */
+typedef struct {
+    uint16_t x;                     /*!< Left edge of the window */
+    uint16_t y;                     /*!< Top edge of the window */
+    uint16_t width;                 /*!< Width of the window, 0 for the rest of the line */
+    uint16_t height;                /*!< Height of the window, 0 for the rest of the frame */
+} camera_window_t;
+
+/**
+ * @brief Band mode events, see camera_config_t::band_cb
+ */
+typedef enum {
+    CAMERA_BAND_FRAME_START,        /*!< A new frame started */
+    CAMERA_BAND_DATA,               /*!< Lines of the current frame are available */
+    CAMERA_BAND_FRAME_END,          /*!< The frame ended, lines tells how many were delivered */
+} camera_band_event_t;
+
+/**
+ * @brief Band mode event data. The buffer is only valid during the callback
+ */
+typedef struct {
+    camera_band_event_t event;      /*!< What happened */
+    const uint8_t * buf;            /*!< Pixel data of the band, for CAMERA_BAND_DATA */
+    size_t len;                     /*!< Length of buf in bytes */
+    size_t width;                   /*!< Width of the frame in pixels */
+    size_t y;                       /*!< Frame line of the first line in buf */
+    size_t lines;                   /*!< Number of lines in buf. For CAMERA_BAND_FRAME_END, lines delivered in the frame */
+    size_t height;                  /*!< Height of the frame in lines */
+    pixformat_t format;             /*!< Format of the pixel data */
+    uint32_t seq;                   /*!< Sequence number of the frame */
+    int64_t timestamp;              /*!< Time of the VSYNC that started the frame, in microseconds since boot */
+} camera_band_t;
+
+/**
+ * @brief Band mode callback. Runs in the DMA filter task and has to return
+ *        before the DMA ring fills up, or lines of the frame are lost
+ */
+typedef void (*camera_band_cb_t)(const camera_band_t * band, void * arg);
+
 /**
  * @brief Configuration structure for camera initialization
  */
@@ -106,8 +169,29 @@ typedef struct {
     size_t fb_count;                /*!< Number of frame buffers to be allocated. If more than one, then each frame will be acquired (double speed)  */
 
     time_t fb_get_timeout;          /* Number of milliseconds to stop fb get*/
+
+    camera_grab_mode_t grab_mode;   /*!< Frame delivery policy when fb_count is more than one. Lost frames are reported in camera_fb_t::dropped */
+
+    int i2s_port;                   /*!< I2S peripheral used for capture, 0 or 1. Each camera needs its own */
+    uint8_t sccb_addr;              /*!< SCCB address of the sensor, 0 to use the first device found on the bus */
+
+    camera_convert_t convert;       /*!< Conversion of YUV422 (or GRAYSCALE, for CAMERA_CONVERT_JPEG) frames done while capturing, saving a second pass over the frame. Ignored for other pixel formats */
+
+    camera_window_t crop;           /*!< Part of the frame to keep, all zero for the full frame. Not available for JPEG */
+    uint8_t decimation;             /*!< Keep one of every n pixels and lines of the crop window, 0 or 1 to keep all. Not available for JPEG */
+
+    camera_band_cb_t band_cb;       /*!< Band mode: when set, no frame buffers are allocated and filtered lines go to this callback as capture runs. Not available for JPEG */
+    void * band_cb_arg;             /*!< Argument passed to band_cb */
+    uint16_t band_lines;            /*!< Lines per band in band mode, 0 for 1 */
+
+    uint8_t target_fps;             /*!< Frames per second to capture, 0 to capture every frame. The sensor is slowed down where it supports it, other frames are skipped at VSYNC without running DMA */
 } camera_config_t;
 
+/**
+ * @brief Sensor setter taking an int, such as sensor_t::set_quality, see esp_camera_control()
+ */
+typedef int (*camera_setter_t)(sensor_t *sensor, int value);
+
 /**
  * @brief Data structure of camera frame buffer
  */
@@ -117,13 +201,60 @@ typedef struct {
     size_t width;               /*!< Width of the buffer in pixels */
     size_t height;              /*!< Height of the buffer in pixels */
     pixformat_t format;         /*!< Format of the pixel data */
+    int64_t timestamp;          /*!< Time of the VSYNC that started the frame, in microseconds since boot (esp_timer_get_time) */
+    uint32_t seq;               /*!< Sequence number of the frame. Dropped frames also take a number, so gaps show skipped frames */
+    uint32_t dropped;           /*!< Number of frames dropped since the previous esp_camera_fb_get() */
+    bool partial;               /*!< The frame ended before its last line, len covers the lines received. Uncompressed formats only */
 } camera_fb_t;
 
+/**
+ * @brief Handle of a camera instance, see esp_camera_handle_init()
+ */
+typedef struct esp_camera_s * esp_camera_handle_t;
+
+/**
+ * @brief Latency summary, in microseconds from the VSYNC that started the frame
+ */
+typedef struct {
+    uint32_t count;             /*!< Number of samples */
+    uint32_t min_us;            /*!< Lowest latency */
+    uint32_t avg_us;            /*!< Average latency */
+    uint32_t p99_us;            /*!< 99th percentile, rounded up to a power of two minus one */
+    uint32_t max_us;            /*!< Highest latency */
+} camera_latency_t;
+
+/**
+ * @brief Driver statistics, see esp_camera_get_stats()
+ */
+typedef struct {
+    uint32_t frames;            /*!< Number of frames delivered or dropped since init */
+    uint32_t dropped;           /*!< Number of frames dropped since init */
+    uint32_t fb_overflows;      /*!< Number of JPEG frames that did not fit in their frame buffer */
+    size_t jpeg_max_len;        /*!< Largest JPEG frame seen since init, in bytes */
+    size_t fb_size;             /*!< Current frame buffer target size, in bytes */
+    uint32_t dma_ring_overruns; /*!< DMA buffers lost because the filter task fell behind */
+    uint32_t dma_ring_max_depth;/*!< Most DMA buffers waiting for the filter task at once */
+    uint32_t fb_queued;         /*!< Frames waiting to be taken with esp_camera_fb_get() */
+    uint64_t isr_time_us;       /*!< CPU time spent in the I2S and VSYNC interrupts. Needs CONFIG_CAMERA_STAGE_STATS */
+    uint64_t filter_time_us;    /*!< CPU time spent converting DMA buffers. Needs CONFIG_CAMERA_STAGE_STATS */
+    uint64_t finish_time_us;    /*!< CPU time spent completing and queueing frames. Needs CONFIG_CAMERA_STAGE_STATS */
+    uint32_t bad_frames;        /*!< Frames dropped for a bad header, missing data or a missing JPEG end marker */
+    uint32_t queue_send_failures; /*!< Frames that could not be put in the output queue */
+    uint32_t fb_overwrites;     /*!< Queued frames replaced by a newer one before they were taken */
+    uint32_t partial_frames;    /*!< Uncompressed frames delivered with camera_fb_t::partial set */
+    uint32_t skipped_frames;    /*!< Frames not captured to keep to camera_config_t::target_fps */
+    camera_latency_t latency_dma;    /*!< VSYNC to the first DMA interrupt */
+    camera_latency_t latency_filter; /*!< VSYNC to the last DMA buffer of the frame being converted */
+    camera_latency_t latency_done;   /*!< VSYNC to the frame being queued for the application */
+    camera_latency_t latency_get;    /*!< VSYNC to the frame being returned by esp_camera_fb_get() */
+} camera_stats_t;
+
 #define ESP_ERR_CAMERA_BASE 0x20000
 #define ESP_ERR_CAMERA_NOT_DETECTED             (ESP_ERR_CAMERA_BASE + 1)
 #define ESP_ERR_CAMERA_FAILED_TO_SET_FRAME_SIZE (ESP_ERR_CAMERA_BASE + 2)
 #define ESP_ERR_CAMERA_FAILED_TO_SET_OUT_FORMAT (ESP_ERR_CAMERA_BASE + 3)
 #define ESP_ERR_CAMERA_NOT_SUPPORTED            (ESP_ERR_CAMERA_BASE + 4)
+#define ESP_ERR_CAMERA_PENDING                  (ESP_ERR_CAMERA_BASE + 5)
 
 /**
  * @brief Initialize the camera driver
@@ -166,6 +297,26 @@ camera_fb_t* esp_camera_fb_get();
  */
 void esp_camera_fb_return(camera_fb_t * fb);
 
+/**
+ * @brief Change frame size, pixel format and JPEG quality without reinitializing the driver
+ *
+ * Capture is stopped, DMA buffers are rebuilt for the new geometry and
+ * frame buffers are reused when they are large enough. Only the sensor's frame size,
+ * pixel format and quality setters are called. Capture resumes with the next
+ * esp_camera_fb_get(). All frame buffers must have been returned.
+ *
+ * @param framesize  New frame size
+ * @param pixformat  New pixel format
+ * @param quality    New JPEG quality, ignored for other formats
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if the driver is not initialized or a frame buffer is still held
+ *      - ESP_ERR_NOT_SUPPORTED if the sensor can not produce the format, the previous settings are kept
+ *      - Other errors leave the driver unusable, call esp_camera_deinit()
+ */
+esp_err_t esp_camera_reconfigure(framesize_t framesize, pixformat_t pixformat, int quality);
+
 /**
  * @brief Get a pointer to the image sensor control structure
  *
@@ -173,6 +324,112 @@ void esp_camera_fb_return(camera_fb_t * fb);
  */
 sensor_t * esp_camera_sensor_get();
 
+/**
+ * @brief Read the driver statistics
+ *
+ * @param stats  Structure to fill
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if the driver hasn't been initialized yet
+ */
+esp_err_t esp_camera_get_stats(camera_stats_t * stats);
+
+/**
+ * @brief Change a sensor setting at the next frame boundary, without waiting for it
+ *
+ * The setter is queued and called by the driver's control task right after
+ * the next VSYNC, together with everything else queued by then, so the change
+ * does not land in the middle of a captured frame. When no capture is running
+ * it is applied at once. Calling the setters directly at the same time is not
+ * safe, the SCCB bus is shared. The frame size and pixel format can not be
+ * changed this way, use esp_camera_reconfigure().
+ *
+ * @param setter  Sensor setter taking an int, e.g. esp_camera_sensor_get()->set_ae_level
+ * @param value   Argument for the setter
+ * @param ticket  Optional, set to the number to pass to esp_camera_control_status()
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the setter is NULL, set_framesize or set_pixformat
+ *      - ESP_ERR_NO_MEM if the queue is full
+ *      - ESP_ERR_INVALID_STATE if the driver hasn't been initialized yet
+ */
+esp_err_t esp_camera_control(camera_setter_t setter, int value, uint32_t * ticket);
+
+/**
+ * @brief Find out whether a change queued with esp_camera_control() is applied
+ *
+ * @param ticket     Ticket returned by esp_camera_control()
+ * @param first_seq  Set to camera_fb_t::seq of the first frame that started after the
+ *                   sensor was written. Some settings (exposure, gain) take the sensor
+ *                   a few more frames to settle
+ *
+ * @return
+ *      - ESP_OK once the first frame with the change is done
+ *      - ESP_ERR_CAMERA_PENDING while the change is queued or that frame is still being captured
+ *      - ESP_FAIL if the setter returned an error
+ *      - ESP_ERR_NOT_FOUND if the ticket is too old to be remembered
+ *      - ESP_ERR_INVALID_ARG if the ticket was never handed out
+ */
+esp_err_t esp_camera_control_status(uint32_t ticket, uint32_t * first_seq);
+
+/**
+ * @brief Initialize a camera instance
+ *
+ * Same as esp_camera_init(), but any number of cameras can be opened as long as
+ * each one uses its own I2S peripheral (config->i2s_port), VSYNC pin and XCLK
+ * LEDC channel. Cameras sharing the SCCB bus need distinct config->sccb_addr.
+ * The functions without a handle act on the camera opened by esp_camera_init().
+ *
+ * @param config      Camera configuration parameters
+ * @param out_handle  Handle of the new camera
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if the I2S peripheral is already in use
+ */
+esp_err_t esp_camera_handle_init(const camera_config_t* config, esp_camera_handle_t* out_handle);
+
+/**
+ * @brief Deinitialize a camera instance, see esp_camera_deinit()
+ */
+esp_err_t esp_camera_handle_deinit(esp_camera_handle_t handle);
+
+/**
+ * @brief Obtain a frame buffer of a camera instance, see esp_camera_fb_get()
+ */
+camera_fb_t* esp_camera_handle_fb_get(esp_camera_handle_t handle);
+
+/**
+ * @brief Return a frame buffer to a camera instance, see esp_camera_fb_return()
+ */
+void esp_camera_handle_fb_return(esp_camera_handle_t handle, camera_fb_t * fb);
+
+/**
+ * @brief Reconfigure a camera instance, see esp_camera_reconfigure()
+ */
+esp_err_t esp_camera_handle_reconfigure(esp_camera_handle_t handle, framesize_t framesize, pixformat_t pixformat, int quality);
+
+/**
+ * @brief Get the sensor of a camera instance, see esp_camera_sensor_get()
+ */
+sensor_t * esp_camera_handle_sensor_get(esp_camera_handle_t handle);
+
+/**
+ * @brief Read the statistics of a camera instance, see esp_camera_get_stats()
+ */
+esp_err_t esp_camera_handle_get_stats(esp_camera_handle_t handle, camera_stats_t * stats);
+
+/**
+ * @brief Queue a sensor change on a camera instance, see esp_camera_control()
+ */
+esp_err_t esp_camera_handle_control(esp_camera_handle_t handle, camera_setter_t setter, int value, uint32_t * ticket);
+
+/**
+ * @brief Status of a queued sensor change on a camera instance, see esp_camera_control_status()
+ */
+esp_err_t esp_camera_handle_control_status(esp_camera_handle_t handle, uint32_t ticket, uint32_t * first_seq);
 
 #ifdef __cplusplus
 }
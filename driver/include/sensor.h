@@ -133,6 +133,9 @@ typedef struct _sensor {
 
     int  (*set_raw_gma)         (sensor_t *sensor, int enable);
     int  (*set_lenc)            (sensor_t *sensor, int enable);
+
+    // Slow the frame timing of the current framesize down by a whole factor. Optional, may be NULL
+    int  (*set_frame_divider)   (sensor_t *sensor, int divider);
 } sensor_t;
 
 // Resolution table (in camera.c)
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "soc/i2s_struct.h"
+#include "rom/lldesc.h"
+#include "sensor.h"
+#include "camera_sim.h"
+
+typedef void (*camera_sim_isr_t)(void* arg);
+
+/*
+ * Hooks used by camera.c in place of the I2S peripheral and the VSYNC GPIO.
+ * sim_bus_init() returns the register block the driver programs as usual;
+ * the simulation task reads it back to know what to do.
+ */
+i2s_dev_t* sim_bus_init(int i2s_port, sensor_t* sensor, camera_sim_isr_t i2s_isr, camera_sim_isr_t vsync_isr, void* arg);
+void sim_bus_deinit(int i2s_port);
+void sim_bus_dma_start(int i2s_port, lldesc_t* desc);
+void sim_bus_i2s_intr_enable(int i2s_port, bool enable);
+void sim_bus_vsync_intr_enable(int i2s_port, bool enable);
+int sim_bus_vsync_level(int i2s_port);
+void sim_sensor_init(sensor_t* sensor);
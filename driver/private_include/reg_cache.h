@@ -0,0 +1,39 @@
+/*
+ * Shadow copy of the sensor registers written by the driver, so that reading
+ * a control back or updating some of its bits does not need an SCCB read.
+ * One cache per sensor address. Only written values are kept, registers
+ * never written are read from the sensor as before.
+ *
+ * Registers the sensor changes on its own (exposure and gain readbacks,
+ * status, firmware mailboxes) are given as uncached ranges and always go to
+ * the sensor. Writing the soft reset bit empties the cache.
+ *
+ * Writes of values the cache already holds are skipped, so a mode switch
+ * only sends the registers that differ. Registers that start an action when
+ * written (resets, group launch, firmware commands) must be in the uncached
+ * ranges, then they are always sent.
+ */
+#ifndef __REG_CACHE_H__
+#define __REG_CACHE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct {
+    uint16_t first;
+    uint16_t last;
+} reg_cache_range_t;
+
+int reg_cache_init(uint8_t slv_addr, const reg_cache_range_t * uncached, size_t uncached_count, uint16_t reset_reg, uint8_t reset_mask);
+void reg_cache_deinit(uint8_t slv_addr);
+void reg_cache_clear(uint8_t slv_addr);
+// Forget the registers first to last, for sensors whose block resets only reset a part of them
+void reg_cache_clear_range(uint8_t slv_addr, uint16_t first, uint16_t last);
+bool reg_cache_get(uint8_t slv_addr, uint16_t reg, uint8_t * value);
+void reg_cache_set(uint8_t slv_addr, uint16_t reg, uint8_t value);
+void reg_cache_set_burst(uint8_t slv_addr, uint16_t reg, const uint8_t * values, size_t len);
+// The len registers from reg are known to hold values already, so writing them can be skipped
+bool reg_cache_match(uint8_t slv_addr, uint16_t reg, const uint8_t * values, size_t len);
+
+#endif /* __REG_CACHE_H__ */
@@ -9,6 +9,11 @@
 #ifndef __SCCB_H__
 #define __SCCB_H__
 #include <stdint.h>
+#include <stddef.h>
+
+// Most registers written in one SCCB_WriteBurst16() by the sensor register lists
+#define SCCB_BURST_MAX 64
+
 int SCCB_Init(int pin_sda, int pin_scl);
 int SCCB_Deinit();
 uint8_t SCCB_Probe();
@@ -16,4 +21,6 @@ uint8_t SCCB_Read(uint8_t slv_addr, uint8_t reg);
 uint8_t SCCB_Write(uint8_t slv_addr, uint8_t reg, uint8_t data);
 uint8_t SCCB_Read16(uint8_t slv_addr, uint16_t reg);
 uint8_t SCCB_Write16(uint8_t slv_addr, uint16_t reg, uint8_t data);
+// Write len registers starting at reg in one transaction, relying on the sensor's address auto-increment
+uint8_t SCCB_WriteBurst16(uint8_t slv_addr, uint16_t reg, const uint8_t * data, size_t len);
 #endif // __SCCB_H__
@@ -0,0 +1,237 @@
+/*
+ * Sensor register shadow cache, see reg_cache.h
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "reg_cache.h"
+
+#if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
+#include "esp32-hal-log.h"
+#define TAG ""
+#else
+#include "esp_log.h"
+static const char* TAG = "reg_cache";
+#endif
+
+#define REG_CACHE_MAX           4           // sensors with a cache, one per camera
+#define REG_CACHE_MIN_SLOTS     256
+#define REG_CACHE_MAX_SLOTS     4096
+
+// slot: bit 31 in use, bits 23..8 register, bits 7..0 value
+#define SLOT_USED               0x80000000UL
+#define SLOT(reg, value)        (SLOT_USED | ((uint32_t)(reg) << 8) | (value))
+#define SLOT_REG(slot)          ((uint16_t)((slot) >> 8))
+#define SLOT_VALUE(slot)        ((uint8_t)(slot))
+
+typedef struct {
+    uint8_t slv_addr;
+    uint16_t reset_reg;
+    uint8_t reset_mask;
+    const reg_cache_range_t * uncached;
+    size_t uncached_count;
+    uint32_t * slots;           // open addressing, linear probing
+    size_t size;                // power of two
+    size_t count;
+} reg_cache_t;
+
+static reg_cache_t * s_caches[REG_CACHE_MAX];
+
+static reg_cache_t * cache_find(uint8_t slv_addr)
+{
+    for (int i = 0; i < REG_CACHE_MAX; i++) {
+        if (s_caches[i] && s_caches[i]->slv_addr == slv_addr) {
+            return s_caches[i];
+        }
+    }
+    return NULL;
+}
+
+static bool cache_uncached(reg_cache_t * c, uint16_t reg)
+{
+    for (size_t i = 0; i < c->uncached_count; i++) {
+        if (reg >= c->uncached[i].first && reg <= c->uncached[i].last) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static inline size_t cache_hash(reg_cache_t * c, uint16_t reg)
+{
+    return (reg * 2654435761UL) & (c->size - 1);
+}
+
+static uint32_t * cache_slot(reg_cache_t * c, uint16_t reg)
+{
+    size_t i = cache_hash(c, reg);
+    while (c->slots[i] && SLOT_REG(c->slots[i]) != reg) {
+        i = (i + 1) & (c->size - 1);
+    }
+    return &c->slots[i];
+}
+
+static bool cache_grow(reg_cache_t * c)
+{
+    size_t size = c->size * 2;
+    if (size > REG_CACHE_MAX_SLOTS) {
+        return false;
+    }
+    uint32_t * slots = (uint32_t *) calloc(size, sizeof(uint32_t));
+    if (!slots) {
+        return false;
+    }
+    uint32_t * old = c->slots;
+    size_t old_size = c->size;
+    c->slots = slots;
+    c->size = size;
+    for (size_t i = 0; i < old_size; i++) {
+        if (old[i]) {
+            *cache_slot(c, SLOT_REG(old[i])) = old[i];
+        }
+    }
+    free(old);
+    return true;
+}
+
+int reg_cache_init(uint8_t slv_addr, const reg_cache_range_t * uncached, size_t uncached_count, uint16_t reset_reg, uint8_t reset_mask)
+{
+    reg_cache_t * c = cache_find(slv_addr);
+    int free_index = -1;
+    if (!c) {
+        for (int i = 0; i < REG_CACHE_MAX && free_index < 0; i++) {
+            if (!s_caches[i]) {
+                free_index = i;
+            }
+        }
+        if (free_index < 0) {
+            ESP_LOGW(TAG, "No register cache left for 0x%02x", slv_addr);
+            return -1;
+        }
+        c = (reg_cache_t *) calloc(1, sizeof(reg_cache_t));
+        if (c) {
+            c->slots = (uint32_t *) calloc(REG_CACHE_MIN_SLOTS, sizeof(uint32_t));
+        }
+        if (!c || !c->slots) {
+            free(c);
+            ESP_LOGW(TAG, "Register cache allocation failed");
+            return -1;
+        }
+        c->size = REG_CACHE_MIN_SLOTS;
+        s_caches[free_index] = c;
+    }
+    c->slv_addr = slv_addr;
+    c->uncached = uncached;
+    c->uncached_count = uncached_count;
+    c->reset_reg = reset_reg;
+    c->reset_mask = reset_mask;
+    reg_cache_clear(slv_addr);
+    return 0;
+}
+
+void reg_cache_deinit(uint8_t slv_addr)
+{
+    for (int i = 0; i < REG_CACHE_MAX; i++) {
+        if (s_caches[i] && s_caches[i]->slv_addr == slv_addr) {
+            free(s_caches[i]->slots);
+            free(s_caches[i]);
+            s_caches[i] = NULL;
+        }
+    }
+}
+
+void reg_cache_clear(uint8_t slv_addr)
+{
+    reg_cache_t * c = cache_find(slv_addr);
+    if (c) {
+        memset(c->slots, 0, c->size * sizeof(uint32_t));
+        c->count = 0;
+    }
+}
+
+void reg_cache_clear_range(uint8_t slv_addr, uint16_t first, uint16_t last)
+{
+    reg_cache_t * c = cache_find(slv_addr);
+    if (!c) {
+        return;
+    }
+    //removing slots would break the probe chains, build the table anew
+    uint32_t * slots = (uint32_t *) calloc(c->size, sizeof(uint32_t));
+    if (!slots) {
+        reg_cache_clear(slv_addr);
+        return;
+    }
+    uint32_t * old = c->slots;
+    c->slots = slots;
+    c->count = 0;
+    for (size_t i = 0; i < c->size; i++) {
+        if (old[i] && (SLOT_REG(old[i]) < first || SLOT_REG(old[i]) > last)) {
+            *cache_slot(c, SLOT_REG(old[i])) = old[i];
+            c->count++;
+        }
+    }
+    free(old);
+}
+
+bool reg_cache_get(uint8_t slv_addr, uint16_t reg, uint8_t * value)
+{
+    reg_cache_t * c = cache_find(slv_addr);
+    if (!c) {
+        return false;
+    }
+    uint32_t slot = *cache_slot(c, reg);
+    if (!slot) {
+        return false;
+    }
+    *value = SLOT_VALUE(slot);
+    return true;
+}
+
+void reg_cache_set(uint8_t slv_addr, uint16_t reg, uint8_t value)
+{
+    reg_cache_t * c = cache_find(slv_addr);
+    if (!c || cache_uncached(c, reg)) {
+        return;
+    }
+    if (reg == c->reset_reg && (value & c->reset_mask)) {
+        //every register goes back to its power on value
+        reg_cache_clear(slv_addr);
+        return;
+    }
+    uint32_t * slot = cache_slot(c, reg);
+    if (!*slot) {
+        //keep the table at most 3/4 full, or probing gets long
+        if ((c->count + 1) * 4 > c->size * 3) {
+            if (!cache_grow(c)) {
+                return;
+            }
+            slot = cache_slot(c, reg);
+        }
+        c->count++;
+    }
+    *slot = SLOT(reg, value);
+}
+
+bool reg_cache_match(uint8_t slv_addr, uint16_t reg, const uint8_t * values, size_t len)
+{
+    reg_cache_t * c = cache_find(slv_addr);
+    if (!c) {
+        return false;
+    }
+    for (size_t i = 0; i < len; i++) {
+        uint32_t slot = *cache_slot(c, reg + i);
+        if (!slot || SLOT_VALUE(slot) != values[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void reg_cache_set_burst(uint8_t slv_addr, uint16_t reg, const uint8_t * values, size_t len)
+{
+    if (!cache_find(slv_addr)) {
+        return;
+    }
+    for (size_t i = 0; i < len; i++) {
+        reg_cache_set(slv_addr, reg + i, values[i]);
+    }
+}
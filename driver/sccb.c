@@ -12,6 +12,7 @@
 #include <freertos/task.h>
 #include "sccb.h"
 #include <stdio.h>
+#include <string.h>
 #include "sdkconfig.h"
 
 #if defined(ARDUINO_ARCH_ESP32) && defined(CONFIG_ARDUHAL_ESP_LOG)
@@ -38,6 +39,7 @@ static const char* TAG = "sccb";
 #define NACK_VAL                0x1              /*!< I2C nack value */
 const int SCCB_I2C_PORT         = 1;
 static uint8_t ESP_SLAVE_ADDR   = 0x3c;
+static bool s_sccb_installed    = false;
 #else
 #include "twi.h"
 #endif
@@ -46,6 +48,10 @@ int SCCB_Init(int pin_sda, int pin_scl)
 {
     ESP_LOGI(TAG, "pin_sda %d pin_scl %d\n", pin_sda, pin_scl);
 #ifdef CONFIG_SCCB_HARDWARE_I2C
+    if (s_sccb_installed) {
+        //cameras share the bus, the first one sets it up
+        return 0;
+    }
     //log_i("SCCB_Init start");
     i2c_config_t conf;
     conf.mode = I2C_MODE_MASTER;
@@ -56,7 +62,7 @@ int SCCB_Init(int pin_sda, int pin_scl)
     conf.master.clk_speed = SCCB_FREQ;
 
     i2c_param_config(SCCB_I2C_PORT, &conf);
-    i2c_driver_install(SCCB_I2C_PORT, conf.mode, 0, 0, 0);
+    s_sccb_installed = i2c_driver_install(SCCB_I2C_PORT, conf.mode, 0, 0, 0) == ESP_OK;
 #else
     twi_init(pin_sda, pin_scl);
 #endif
@@ -66,6 +72,7 @@ int SCCB_Init(int pin_sda, int pin_scl)
 int SCCB_Deinit() {
 #ifdef CONFIG_SCCB_HARDWARE_I2C
     i2c_driver_delete(SCCB_I2C_PORT);
+    s_sccb_installed = false;
 #else
     
 #endif
@@ -115,7 +122,7 @@ uint8_t SCCB_Read(uint8_t slv_addr, uint8_t reg)
     esp_err_t ret = ESP_FAIL;
     i2c_cmd_handle_t cmd = i2c_cmd_link_create();
     i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, ( ESP_SLAVE_ADDR << 1 ) | WRITE_BIT, ACK_CHECK_EN);
+    i2c_master_write_byte(cmd, ( slv_addr << 1 ) | WRITE_BIT, ACK_CHECK_EN);
     i2c_master_write_byte(cmd, reg, ACK_CHECK_EN);
     i2c_master_stop(cmd);
     ret = i2c_master_cmd_begin(SCCB_I2C_PORT, cmd, 1000 / portTICK_RATE_MS);
@@ -123,13 +130,13 @@ uint8_t SCCB_Read(uint8_t slv_addr, uint8_t reg)
     if(ret != ESP_OK) return -1;
     cmd = i2c_cmd_link_create();
     i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, ( ESP_SLAVE_ADDR << 1 ) | READ_BIT, ACK_CHECK_EN);
+    i2c_master_write_byte(cmd, ( slv_addr << 1 ) | READ_BIT, ACK_CHECK_EN);
     i2c_master_read_byte(cmd, &data, NACK_VAL);
     i2c_master_stop(cmd);
     ret = i2c_master_cmd_begin(SCCB_I2C_PORT, cmd, 1000 / portTICK_RATE_MS);
     i2c_cmd_link_delete(cmd);
     if(ret != ESP_OK) {
-        ESP_LOGE(TAG, "SCCB_Read Failed addr:0x%02x, reg:0x%02x, data:0x%02x, ret:%d", ESP_SLAVE_ADDR, reg, data, ret);
+        ESP_LOGE(TAG, "SCCB_Read Failed addr:0x%02x, reg:0x%02x, data:0x%02x, ret:%d", slv_addr, reg, data, ret);
     }
     return data;
 #else
@@ -157,14 +164,14 @@ uint8_t SCCB_Write(uint8_t slv_addr, uint8_t reg, uint8_t data)
     esp_err_t ret = ESP_FAIL;
     i2c_cmd_handle_t cmd = i2c_cmd_link_create();
     i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, ( ESP_SLAVE_ADDR << 1 ) | WRITE_BIT, ACK_CHECK_EN);
+    i2c_master_write_byte(cmd, ( slv_addr << 1 ) | WRITE_BIT, ACK_CHECK_EN);
     i2c_master_write_byte(cmd, reg, ACK_CHECK_EN);
     i2c_master_write_byte(cmd, data, ACK_CHECK_EN);
     i2c_master_stop(cmd);
     ret = i2c_master_cmd_begin(SCCB_I2C_PORT, cmd, 1000 / portTICK_RATE_MS);
     i2c_cmd_link_delete(cmd);
     if(ret != ESP_OK) {
-        ESP_LOGE(TAG, "SCCB_Write Failed addr:0x%02x, reg:0x%02x, data:0x%02x, ret:%d", ESP_SLAVE_ADDR, reg, data, ret);
+        ESP_LOGE(TAG, "SCCB_Write Failed addr:0x%02x, reg:0x%02x, data:0x%02x, ret:%d", slv_addr, reg, data, ret);
     }
     return ret == ESP_OK ? 0 : -1;
 #else
@@ -190,7 +197,7 @@ uint8_t SCCB_Read16(uint8_t slv_addr, uint16_t reg)
     uint8_t *reg_u8 = (uint8_t *)&reg_htons;
     i2c_cmd_handle_t cmd = i2c_cmd_link_create();
     i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, ( ESP_SLAVE_ADDR << 1 ) | WRITE_BIT, ACK_CHECK_EN);
+    i2c_master_write_byte(cmd, ( slv_addr << 1 ) | WRITE_BIT, ACK_CHECK_EN);
     i2c_master_write_byte(cmd, reg_u8[0], ACK_CHECK_EN);
     i2c_master_write_byte(cmd, reg_u8[1], ACK_CHECK_EN);
     i2c_master_stop(cmd);
@@ -199,7 +206,7 @@ uint8_t SCCB_Read16(uint8_t slv_addr, uint16_t reg)
     if(ret != ESP_OK) return -1;
     cmd = i2c_cmd_link_create();
     i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, ( ESP_SLAVE_ADDR << 1 ) | READ_BIT, ACK_CHECK_EN);
+    i2c_master_write_byte(cmd, ( slv_addr << 1 ) | READ_BIT, ACK_CHECK_EN);
     i2c_master_read_byte(cmd, &data, NACK_VAL);
     i2c_master_stop(cmd);
     ret = i2c_master_cmd_begin(SCCB_I2C_PORT, cmd, 1000 / portTICK_RATE_MS);
@@ -239,7 +246,7 @@ uint8_t SCCB_Write16(uint8_t slv_addr, uint16_t reg, uint8_t data)
     uint8_t *reg_u8 = (uint8_t *)&reg_htons;
     i2c_cmd_handle_t cmd = i2c_cmd_link_create();
     i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, ( ESP_SLAVE_ADDR << 1 ) | WRITE_BIT, ACK_CHECK_EN);
+    i2c_master_write_byte(cmd, ( slv_addr << 1 ) | WRITE_BIT, ACK_CHECK_EN);
     i2c_master_write_byte(cmd, reg_u8[0], ACK_CHECK_EN);
     i2c_master_write_byte(cmd, reg_u8[1], ACK_CHECK_EN);
     i2c_master_write_byte(cmd, data, ACK_CHECK_EN);
@@ -265,3 +272,44 @@ uint8_t SCCB_Write16(uint8_t slv_addr, uint16_t reg, uint8_t data)
     return ret;
 #endif
 }
+
+uint8_t SCCB_WriteBurst16(uint8_t slv_addr, uint16_t reg, const uint8_t * data, size_t len)
+{
+#ifdef CONFIG_SCCB_HARDWARE_I2C
+    esp_err_t ret = ESP_FAIL;
+    uint16_t reg_htons = LITTLETOBIG(reg);
+    uint8_t *reg_u8 = (uint8_t *)&reg_htons;
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, ( slv_addr << 1 ) | WRITE_BIT, ACK_CHECK_EN);
+    i2c_master_write_byte(cmd, reg_u8[0], ACK_CHECK_EN);
+    i2c_master_write_byte(cmd, reg_u8[1], ACK_CHECK_EN);
+    i2c_master_write(cmd, (uint8_t *)data, len, ACK_CHECK_EN);
+    i2c_master_stop(cmd);
+    ret = i2c_master_cmd_begin(SCCB_I2C_PORT, cmd, 1000 / portTICK_RATE_MS);
+    i2c_cmd_link_delete(cmd);
+    if(ret != ESP_OK) {
+        ESP_LOGE(TAG, "W [%04x]+%u fail\n", reg, len);
+    }
+    return ret == ESP_OK ? 0 : -1;
+#else
+    uint8_t ret=0;
+    uint8_t buf[2 + SCCB_BURST_MAX];
+
+    //one transaction per chunk, each starting at its own address
+    while (len && ret == 0) {
+        size_t n = len < SCCB_BURST_MAX ? len : SCCB_BURST_MAX;
+        buf[0] = reg >> 8;
+        buf[1] = reg & 0xFF;
+        memcpy(buf + 2, data, n);
+        if(twi_writeTo(slv_addr, buf, n + 2, true) != 0) {
+            ret = 0xFF;
+            ESP_LOGE(TAG, "W [%04x]+%u fail\n", reg, n);
+        }
+        reg += n;
+        data += n;
+        len -= n;
+    }
+    return ret;
+#endif
+}
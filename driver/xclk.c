@@ -11,6 +11,9 @@
 static const char* TAG = "camera_xclk";
 #endif
 
+// LEDC channels driving an XCLK, the module is powered while any is in use
+static uint32_t s_ledc_channels_used = 0;
+
 esp_err_t camera_enable_out_clock(camera_config_t* config)
 {
     periph_module_enable(PERIPH_LEDC_MODULE);
@@ -39,10 +42,15 @@ esp_err_t camera_enable_out_clock(camera_config_t* config)
         ESP_LOGE(TAG, "ledc_channel_config failed, rc=%x", err);
         return err;
     }
+    s_ledc_channels_used |= 1UL << config->ledc_channel;
     return ESP_OK;
 }
 
-void camera_disable_out_clock()
+void camera_disable_out_clock(camera_config_t* config)
 {
-    periph_module_disable(PERIPH_LEDC_MODULE);
+    ledc_stop(LEDC_HIGH_SPEED_MODE, config->ledc_channel, 0);
+    s_ledc_channels_used &= ~(1UL << config->ledc_channel);
+    if (!s_ledc_channels_used) {
+        periph_module_disable(PERIPH_LEDC_MODULE);
+    }
 }
@@ -0,0 +1,10 @@
+#pragma once
+
+typedef enum {
+    PERIPH_LEDC_MODULE = 0,
+    PERIPH_I2S0_MODULE,
+    PERIPH_I2S1_MODULE,
+} periph_module_t;
+
+#define periph_module_enable(module) ((void) (module))
+#define periph_module_disable(module) ((void) (module))
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <stdbool.h>
+#include "driver/gpio.h"
+
+#define rtc_gpio_is_valid_gpio(gpio_num) false
+#define rtc_gpio_deinit(gpio_num) ESP_OK
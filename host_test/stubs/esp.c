@@ -0,0 +1,146 @@
+/*
+ * ESP-IDF functions used by the driver and the conversions, for the host.
+ * Peripherals are not there: the GPIO and interrupt calls do nothing, the
+ * simulated bus takes the place of I2S.
+ */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_intr_alloc.h"
+#include "driver/gpio.h"
+#include "soc/i2s_struct.h"
+
+i2s_dev_t I2S0;
+i2s_dev_t I2S1;
+gpio_dev_t GPIO;
+
+static esp_log_level_t s_log_level = ESP_LOG_WARN;
+
+int64_t esp_timer_get_time(void)
+{
+    static int64_t start;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    int64_t now = (int64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+    if (!start) {
+        start = now;
+    }
+    return now - start;
+}
+
+void esp_log_level_set(const char* tag, esp_log_level_t level)
+{
+    s_log_level = level;
+}
+
+void esp_log_write(esp_log_level_t level, const char* tag, const char* format, ...)
+{
+    static const char letters[] = "NEWIDV";
+    if (level > s_log_level) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "%c (%lld) %s: ", letters[level], (long long) (esp_timer_get_time() / 1000), tag);
+    vfprintf(stderr, format, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+void* heap_caps_malloc(size_t size, uint32_t caps)
+{
+    return malloc(size);
+}
+
+void* heap_caps_calloc(size_t n, size_t size, uint32_t caps)
+{
+    return calloc(n, size);
+}
+
+void* heap_caps_realloc(void* ptr, size_t size, uint32_t caps)
+{
+    return realloc(ptr, size);
+}
+
+void heap_caps_free(void* ptr)
+{
+    free(ptr);
+}
+
+size_t heap_caps_get_free_size(uint32_t caps)
+{
+    return 4 * 1024 * 1024;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps)
+{
+    return 4 * 1024 * 1024;
+}
+
+esp_err_t esp_intr_alloc(int source, int flags, intr_handler_t handler, void* arg, intr_handle_t* ret_handle)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_intr_enable(intr_handle_t handle)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_intr_disable(intr_handle_t handle)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_intr_free(intr_handle_t handle)
+{
+    return ESP_OK;
+}
+
+esp_err_t gpio_config(const gpio_config_t* config)
+{
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+    return 0;
+}
+
+esp_err_t gpio_set_intr_type(gpio_num_t gpio_num, gpio_int_type_t intr_type)
+{
+    return ESP_OK;
+}
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags)
+{
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void* args)
+{
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num)
+{
+    return ESP_OK;
+}
+
+void gpio_matrix_in(uint32_t gpio, uint32_t signal_idx, bool inv)
+{
+}
+
+void gpio_matrix_out(uint32_t gpio, uint32_t signal_idx, bool out_inv, bool oen_inv)
+{
+}
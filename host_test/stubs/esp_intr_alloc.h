@@ -0,0 +1,18 @@
+#pragma once
+
+#include "esp_err.h"
+
+typedef struct intr_handle_data_t* intr_handle_t;
+typedef void (*intr_handler_t)(void* arg);
+
+#define ESP_INTR_FLAG_LEVEL1        (1 << 1)
+#define ESP_INTR_FLAG_IRAM          (1 << 10)
+#define ESP_INTR_FLAG_INTRDISABLED  (1 << 11)
+
+#define ETS_I2S0_INTR_SOURCE        32
+#define ETS_I2S1_INTR_SOURCE        33
+
+esp_err_t esp_intr_alloc(int source, int flags, intr_handler_t handler, void* arg, intr_handle_t* ret_handle);
+esp_err_t esp_intr_enable(intr_handle_t handle);
+esp_err_t esp_intr_disable(intr_handle_t handle);
+esp_err_t esp_intr_free(intr_handle_t handle);
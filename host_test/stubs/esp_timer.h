@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// microseconds since the program started
+int64_t esp_timer_get_time(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,431 @@
+/*
+ * FreeRTOS API on POSIX threads, see freertos/FreeRTOS.h
+ *
+ * One lock guards every queue and task, and one condition variable is
+ * broadcast on every change. Slow, but simple enough to trust when a test
+ * fails: the driver is what is being tested, not this file.
+ */
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_timer.h"
+
+struct host_task {
+    pthread_t thread;
+    TaskFunction_t fn;
+    void* arg;
+    const char* name;
+    uint32_t notify;
+    eTaskState state;
+    bool delete_pending;
+};
+
+struct host_queue {
+    UBaseType_t length;
+    UBaseType_t item_size;
+    UBaseType_t count;
+    UBaseType_t head;
+    uint8_t* items;
+};
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_changed = PTHREAD_COND_INITIALIZER;
+static pthread_mutex_t s_critical;
+static pthread_once_t s_critical_once = PTHREAD_ONCE_INIT;
+static __thread struct host_task* s_self;
+
+static struct host_task* current_task(void)
+{
+    if (!s_self) {
+        //the main thread, or a thread the test started itself
+        s_self = (struct host_task*) calloc(1, sizeof(struct host_task));
+        s_self->thread = pthread_self();
+        s_self->name = "main";
+        s_self->state = eRunning;
+    }
+    return s_self;
+}
+
+static void deadline_after(struct timespec* ts, TickType_t ticks)
+{
+    clock_gettime(CLOCK_MONOTONIC, ts);
+    uint64_t ns = (uint64_t) ticks * (1000000000ULL / configTICK_RATE_HZ) + ts->tv_nsec;
+    ts->tv_sec += ns / 1000000000ULL;
+    ts->tv_nsec = ns % 1000000000ULL;
+}
+
+static void task_exit_locked(struct host_task* self)
+{
+    self->state = eDeleted;
+    pthread_cond_broadcast(&s_changed);
+    pthread_mutex_unlock(&s_lock);
+    pthread_exit(NULL);
+}
+
+/*
+ * Wait for a change with s_lock held. Returns false once the deadline has
+ * passed, never waits for ticks == 0. A task that was deleted before or
+ * while waiting ends here.
+ */
+static bool wait_locked(TickType_t ticks, const struct timespec* deadline)
+{
+    struct host_task* self = current_task();
+    if (self->delete_pending) {
+        task_exit_locked(self);
+    }
+    if (ticks == 0) {
+        return false;
+    }
+    self->state = eBlocked;
+    int rc = 0;
+    if (ticks == portMAX_DELAY) {
+        pthread_cond_wait(&s_changed, &s_lock);
+    } else {
+        rc = pthread_cond_timedwait(&s_changed, &s_lock, deadline);
+    }
+    self->state = eRunning;
+    if (self->delete_pending) {
+        task_exit_locked(self);
+    }
+    return rc != ETIMEDOUT;
+}
+
+static void* task_main(void* arg)
+{
+    struct host_task* self = (struct host_task*) arg;
+    s_self = self;
+    self->fn(self->arg);
+    //FreeRTOS tasks must not return, treat it as vTaskDelete(NULL)
+    pthread_mutex_lock(&s_lock);
+    task_exit_locked(self);
+    return NULL;
+}
+
+static pthread_condattr_t* monotonic_attr(void)
+{
+    static pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    return &attr;
+}
+
+__attribute__((constructor)) static void freertos_host_init(void)
+{
+    pthread_cond_destroy(&s_changed);
+    pthread_cond_init(&s_changed, monotonic_attr());
+    esp_timer_get_time();
+}
+
+static void critical_init(void)
+{
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&s_critical, &attr);
+}
+
+// one lock stands in for every spinlock, interrupts are plain calls on other threads
+void vPortEnterCritical(portMUX_TYPE* mux)
+{
+    pthread_once(&s_critical_once, critical_init);
+    pthread_mutex_lock(&s_critical);
+}
+
+void vPortExitCritical(portMUX_TYPE* mux)
+{
+    pthread_mutex_unlock(&s_critical);
+}
+
+/*
+ * Tasks
+ */
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stack_depth, void* arg, UBaseType_t priority, TaskHandle_t* created)
+{
+    struct host_task* task = (struct host_task*) calloc(1, sizeof(struct host_task));
+    if (!task) {
+        return pdFAIL;
+    }
+    task->fn = fn;
+    task->arg = arg;
+    task->name = name;
+    task->state = eReady;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    //handles are never freed: interrupt handlers may still notify a deleted task
+    if (created) {
+        *created = task;
+    }
+    if (pthread_create(&task->thread, &attr, task_main, task) != 0) {
+        pthread_attr_destroy(&attr);
+        if (created) {
+            *created = NULL;
+        }
+        free(task);
+        return pdFAIL;
+    }
+    pthread_attr_destroy(&attr);
+    return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack_depth, void* arg, UBaseType_t priority, TaskHandle_t* created, BaseType_t core_id)
+{
+    return xTaskCreate(fn, name, stack_depth, arg, priority, created);
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    struct host_task* self = current_task();
+    pthread_mutex_lock(&s_lock);
+    if (!task || task == self) {
+        task_exit_locked(self);
+    }
+    task->delete_pending = true;
+    pthread_cond_broadcast(&s_changed);
+    while (task->state != eDeleted) {
+        pthread_cond_wait(&s_changed, &s_lock);
+    }
+    pthread_mutex_unlock(&s_lock);
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    if (ticks == 0) {
+        sched_yield();
+        return;
+    }
+    struct timespec deadline;
+    deadline_after(&deadline, ticks);
+    pthread_mutex_lock(&s_lock);
+    while (wait_locked(ticks, &deadline)) {
+    }
+    pthread_mutex_unlock(&s_lock);
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t) (esp_timer_get_time() / (1000000 / configTICK_RATE_HZ));
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return current_task();
+}
+
+eTaskState eTaskGetState(TaskHandle_t task)
+{
+    pthread_mutex_lock(&s_lock);
+    eTaskState state = task->state;
+    pthread_mutex_unlock(&s_lock);
+    return state;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks)
+{
+    struct host_task* self = current_task();
+    struct timespec deadline;
+    deadline_after(&deadline, ticks);
+    pthread_mutex_lock(&s_lock);
+    while (!self->notify && wait_locked(ticks, &deadline)) {
+    }
+    uint32_t value = self->notify;
+    if (value) {
+        self->notify = clear_on_exit ? 0 : value - 1;
+    }
+    pthread_mutex_unlock(&s_lock);
+    return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    pthread_mutex_lock(&s_lock);
+    if (task->state != eDeleted) {
+        task->notify++;
+        pthread_cond_broadcast(&s_changed);
+    }
+    pthread_mutex_unlock(&s_lock);
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higher_priority_task_woken)
+{
+    xTaskNotifyGive(task);
+    if (higher_priority_task_woken) {
+        *higher_priority_task_woken = pdTRUE;
+    }
+}
+
+void taskYIELD(void)
+{
+    sched_yield();
+}
+
+/*
+ * Queues and semaphores
+ */
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    struct host_queue* q = (struct host_queue*) calloc(1, sizeof(struct host_queue));
+    if (!q) {
+        return NULL;
+    }
+    q->length = length;
+    q->item_size = item_size;
+    if (item_size) {
+        q->items = (uint8_t*) malloc((size_t) length * item_size);
+        if (!q->items) {
+            free(q);
+            return NULL;
+        }
+    }
+    return q;
+}
+
+QueueHandle_t xQueueCreateCountingSemaphore(UBaseType_t max_count, UBaseType_t initial_count)
+{
+    QueueHandle_t q = xQueueCreate(max_count, 0);
+    if (q) {
+        q->count = initial_count;
+    }
+    return q;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    free(queue->items);
+    free(queue);
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue)
+{
+    pthread_mutex_lock(&s_lock);
+    queue->count = 0;
+    queue->head = 0;
+    pthread_cond_broadcast(&s_changed);
+    pthread_mutex_unlock(&s_lock);
+    return pdPASS;
+}
+
+static BaseType_t queue_send(QueueHandle_t q, const void* item, TickType_t ticks, bool front)
+{
+    struct timespec deadline;
+    deadline_after(&deadline, ticks);
+    pthread_mutex_lock(&s_lock);
+    while (q->count == q->length) {
+        if (!wait_locked(ticks, &deadline) && q->count == q->length) {
+            pthread_mutex_unlock(&s_lock);
+            return pdFAIL;
+        }
+    }
+    UBaseType_t slot;
+    if (front) {
+        q->head = (q->head + q->length - 1) % q->length;
+        slot = q->head;
+    } else {
+        slot = (q->head + q->count) % q->length;
+    }
+    if (q->item_size) {
+        memcpy(q->items + (size_t) slot * q->item_size, item, q->item_size);
+    }
+    q->count++;
+    pthread_cond_broadcast(&s_changed);
+    pthread_mutex_unlock(&s_lock);
+    return pdPASS;
+}
+
+static BaseType_t queue_receive(QueueHandle_t q, void* item, TickType_t ticks, bool peek)
+{
+    struct timespec deadline;
+    deadline_after(&deadline, ticks);
+    pthread_mutex_lock(&s_lock);
+    while (q->count == 0) {
+        if (!wait_locked(ticks, &deadline) && q->count == 0) {
+            pthread_mutex_unlock(&s_lock);
+            return pdFAIL;
+        }
+    }
+    if (q->item_size) {
+        memcpy(item, q->items + (size_t) q->head * q->item_size, q->item_size);
+    }
+    if (!peek) {
+        q->head = (q->head + 1) % q->length;
+        q->count--;
+        pthread_cond_broadcast(&s_changed);
+    }
+    pthread_mutex_unlock(&s_lock);
+    return pdPASS;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks)
+{
+    return queue_send(queue, item, ticks, false);
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void* item, TickType_t ticks)
+{
+    return queue_send(queue, item, ticks, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void* item, TickType_t ticks)
+{
+    return queue_send(queue, item, ticks, true);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks)
+{
+    return queue_receive(queue, item, ticks, false);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void* item, TickType_t ticks)
+{
+    return queue_receive(queue, item, ticks, true);
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    pthread_mutex_lock(&s_lock);
+    UBaseType_t count = queue->count;
+    pthread_mutex_unlock(&s_lock);
+    return count;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* higher_priority_task_woken)
+{
+    BaseType_t ret = queue_send(queue, item, 0, false);
+    if (ret == pdPASS && higher_priority_task_woken) {
+        *higher_priority_task_woken = pdTRUE;
+    }
+    return ret;
+}
+
+BaseType_t xQueueReceiveFromISR(QueueHandle_t queue, void* item, BaseType_t* higher_priority_task_woken)
+{
+    BaseType_t ret = queue_receive(queue, item, 0, false);
+    if (ret == pdPASS && higher_priority_task_woken) {
+        *higher_priority_task_woken = pdTRUE;
+    }
+    return ret;
+}
+
+BaseType_t xQueueIsQueueFullFromISR(QueueHandle_t queue)
+{
+    return uxQueueMessagesWaiting(queue) == queue->length;
+}
+
+BaseType_t xQueueIsQueueEmptyFromISR(QueueHandle_t queue)
+{
+    return uxQueueMessagesWaiting(queue) == 0;
+}
+
+UBaseType_t uxQueueMessagesWaitingFromISR(QueueHandle_t queue)
+{
+    return uxQueueMessagesWaiting(queue);
+}
@@ -0,0 +1,57 @@
+/*
+ * The part of the FreeRTOS API used by the driver, on top of POSIX threads.
+ * Tasks are threads, priorities and core affinity are ignored. Interrupt
+ * handlers of the simulated bus run in its own thread, so the *FromISR
+ * functions are the same as the others with no timeout.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "sdkconfig.h"
+#include "esp_attr.h"
+// the ESP-IDF FreeRTOS headers bring these in as well
+#include "esp_heap_caps.h"
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE             0
+#define pdTRUE              1
+#define pdFAIL              pdFALSE
+#define pdPASS              pdTRUE
+
+#define configTICK_RATE_HZ  1000
+#define portMAX_DELAY       ((TickType_t) 0xffffffffUL)
+#define portTICK_PERIOD_MS  ((TickType_t) 1000 / configTICK_RATE_HZ)
+#define portTICK_RATE_MS    portTICK_PERIOD_MS
+#define pdMS_TO_TICKS(ms)   ((TickType_t) (((TickType_t) (ms) * (TickType_t) configTICK_RATE_HZ) / (TickType_t) 1000))
+#define portNUM_PROCESSORS  2
+
+// interrupt handlers are plain function calls on the host
+#define portYIELD_FROM_ISR()    do {} while (0)
+
+typedef struct {
+    int unused;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED { 0 }
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void vPortEnterCritical(portMUX_TYPE* mux);
+void vPortExitCritical(portMUX_TYPE* mux);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define portENTER_CRITICAL(mux)         vPortEnterCritical(mux)
+#define portEXIT_CRITICAL(mux)          vPortExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux)     vPortEnterCritical(mux)
+#define portEXIT_CRITICAL_ISR(mux)      vPortExitCritical(mux)
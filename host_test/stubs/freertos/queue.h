@@ -0,0 +1,33 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct host_queue* QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+void vQueueDelete(QueueHandle_t queue);
+BaseType_t xQueueReset(QueueHandle_t queue);
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks);
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void* item, TickType_t ticks);
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void* item, TickType_t ticks);
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks);
+BaseType_t xQueuePeek(QueueHandle_t queue, void* item, TickType_t ticks);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* higher_priority_task_woken);
+BaseType_t xQueueReceiveFromISR(QueueHandle_t queue, void* item, BaseType_t* higher_priority_task_woken);
+BaseType_t xQueueIsQueueFullFromISR(QueueHandle_t queue);
+BaseType_t xQueueIsQueueEmptyFromISR(QueueHandle_t queue);
+UBaseType_t uxQueueMessagesWaitingFromISR(QueueHandle_t queue);
+
+// semaphores are queues of empty items, as in FreeRTOS
+QueueHandle_t xQueueCreateCountingSemaphore(UBaseType_t max_count, UBaseType_t initial_count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "freertos/queue.h"
+
+typedef QueueHandle_t SemaphoreHandle_t;
+
+#define xSemaphoreCreateBinary()                xQueueCreateCountingSemaphore(1, 0)
+#define xSemaphoreCreateMutex()                 xQueueCreateCountingSemaphore(1, 1)
+#define xSemaphoreCreateCounting(max, initial)  xQueueCreateCountingSemaphore(max, initial)
+#define vSemaphoreDelete(sem)                   vQueueDelete(sem)
+#define xSemaphoreTake(sem, ticks)              xQueueReceive(sem, NULL, ticks)
+#define xSemaphoreGive(sem)                     xQueueSend(sem, NULL, 0)
+#define xSemaphoreGiveFromISR(sem, woken)       xQueueSendFromISR(sem, NULL, woken)
+#define xSemaphoreTakeFromISR(sem, woken)       xQueueReceiveFromISR(sem, NULL, woken)
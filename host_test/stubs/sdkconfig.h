@@ -0,0 +1,10 @@
+/*
+ * Configuration of the host build: the simulated bus stands in for the
+ * I2S peripheral, no sensor drivers are built.
+ */
+#pragma once
+
+#define CONFIG_CAMERA_SIM_BACKEND 1
+#define CONFIG_CAMERA_SIM_PCLK_HZ 0
+#define CONFIG_CAMERA_STAGE_STATS 1
+#define CONFIG_CAMERA_DMA_BATCH_LINES 1
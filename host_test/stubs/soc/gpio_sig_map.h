@@ -0,0 +1,12 @@
+#pragma once
+
+#define I2S0I_DATA_IN0_IDX      140
+#define I2S0I_V_SYNC_IDX        190
+#define I2S0I_H_SYNC_IDX        191
+#define I2S0I_H_ENABLE_IDX      192
+#define I2S0I_WS_IN_IDX         13
+#define I2S1I_DATA_IN0_IDX      164
+#define I2S1I_V_SYNC_IDX        193
+#define I2S1I_H_SYNC_IDX        194
+#define I2S1I_H_ENABLE_IDX      195
+#define I2S1I_WS_IN_IDX         17
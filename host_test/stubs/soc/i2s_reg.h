@@ -0,0 +1,13 @@
+#pragma once
+
+// CONF
+#define I2S_TX_RESET_M          (1 << 0)
+#define I2S_RX_RESET_M          (1 << 1)
+#define I2S_TX_FIFO_RESET_M     (1 << 2)
+#define I2S_RX_FIFO_RESET_M     (1 << 3)
+
+// LC_CONF
+#define I2S_IN_RST_M            (1 << 0)
+#define I2S_OUT_RST_M           (1 << 1)
+#define I2S_AHBM_FIFO_RST_M     (1 << 2)
+#define I2S_AHBM_RST_M          (1 << 3)
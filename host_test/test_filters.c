@@ -0,0 +1,247 @@
+/*
+ * The word-wide DMA filters and their byte-wise variants against the
+ * byte-wise filters they replaced, for every sampling mode and for DMA
+ * buffers whose length leaves a tail (length & 7). The output has to be the
+ * same byte for byte, and nothing may be written past it.
+ *
+ *   test_filters          compare
+ *   test_filters bench    compare, then time each filter against its reference
+ */
+#include "../driver/camera.c"
+
+#include <stdio.h>
+#include <time.h>
+
+/*
+ * Reference filters, as they were before the word-wide versions. The packed
+ * JPEG one had no word-wide version yet, it is the first byte-wise one.
+ */
+static void ref_filter_jpeg(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst) {
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 4;
+    // manually unrolling 4 iterations of the loop here
+    for (size_t i = 0; i < end; ++i) {
+        dst[0] = src[0].sample1;
+        dst[1] = src[1].sample1;
+        dst[2] = src[2].sample1;
+        dst[3] = src[3].sample1;
+        src += 4;
+        dst += 4;
+    }
+}
+
+static void ref_filter_jpeg_packed(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst) {
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 4;
+    for (size_t i = 0; i < end; ++i) {
+        dst[0] = src[0].sample1;
+        dst[1] = src[0].sample2;
+        dst[2] = src[1].sample1;
+        dst[3] = src[1].sample2;
+        dst[4] = src[2].sample1;
+        dst[5] = src[2].sample2;
+        dst[6] = src[3].sample1;
+        dst[7] = src[3].sample2;
+        src += 4;
+        dst += 8;
+    }
+}
+
+static void ref_filter_grayscale(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst) {
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 4;
+    for (size_t i = 0; i < end; ++i) {
+        // manually unrolling 4 iterations of the loop here
+        dst[0] = src[0].sample1;
+        dst[1] = src[1].sample1;
+        dst[2] = src[2].sample1;
+        dst[3] = src[3].sample1;
+        src += 4;
+        dst += 4;
+    }
+}
+
+static void ref_filter_grayscale_highspeed(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst) {
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 8;
+    for (size_t i = 0; i < end; ++i) {
+        // manually unrolling 4 iterations of the loop here
+        dst[0] = src[0].sample1;
+        dst[1] = src[2].sample1;
+        dst[2] = src[4].sample1;
+        dst[3] = src[6].sample1;
+        src += 8;
+        dst += 4;
+    }
+    // the final sample of a line in SM_0A0B_0B0C sampling mode needs special handling
+    if ((dma_desc->length & 0x7) != 0) {
+        dst[0] = src[0].sample1;
+        dst[1] = src[2].sample1;
+    }
+}
+
+static void ref_filter_yuyv(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst)
+{
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 4;
+    for (size_t i = 0; i < end; ++i) {
+        dst[0] = src[0].sample1;//y0
+        dst[1] = src[0].sample2;//u
+        dst[2] = src[1].sample1;//y1
+        dst[3] = src[1].sample2;//v
+
+        dst[4] = src[2].sample1;//y0
+        dst[5] = src[2].sample2;//u
+        dst[6] = src[3].sample1;//y1
+        dst[7] = src[3].sample2;//v
+        src += 4;
+        dst += 8;
+    }
+}
+
+static void ref_filter_yuyv_highspeed(const dma_elem_t* src, lldesc_t* dma_desc, uint8_t* dst)
+{
+    size_t end = dma_desc->length / sizeof(dma_elem_t) / 8;
+    for (size_t i = 0; i < end; ++i) {
+        dst[0] = src[0].sample1;//y0
+        dst[1] = src[1].sample1;//u
+        dst[2] = src[2].sample1;//y1
+        dst[3] = src[3].sample1;//v
+
+        dst[4] = src[4].sample1;//y0
+        dst[5] = src[5].sample1;//u
+        dst[6] = src[6].sample1;//y1
+        dst[7] = src[7].sample1;//v
+        src += 8;
+        dst += 8;
+    }
+    if ((dma_desc->length & 0x7) != 0) {
+        dst[0] = src[0].sample1;//y0
+        dst[1] = src[1].sample1;//u
+        dst[2] = src[2].sample1;//y1
+        dst[3] = src[2].sample2;//v
+    }
+}
+
+typedef struct {
+    const char* name;
+    dma_filter_t ref;
+    dma_filter_t word;
+    dma_filter_t bytes;
+} filter_case_t;
+
+static const filter_case_t s_cases[] = {
+    { "jpeg",                   ref_filter_jpeg,                dma_filter_jpeg,                dma_filter_jpeg_bytes },
+    { "jpeg_packed",            ref_filter_jpeg_packed,         dma_filter_jpeg_packed,         dma_filter_jpeg_packed_bytes },
+    { "grayscale",              ref_filter_grayscale,           dma_filter_grayscale,           dma_filter_grayscale_bytes },
+    { "grayscale_highspeed",    ref_filter_grayscale_highspeed, dma_filter_grayscale_highspeed, dma_filter_grayscale_highspeed_bytes },
+    { "yuyv",                   ref_filter_yuyv,                dma_filter_yuyv,                dma_filter_yuyv_bytes },
+    { "yuyv_highspeed",         ref_filter_yuyv_highspeed,      dma_filter_yuyv_highspeed,      dma_filter_yuyv_highspeed_bytes },
+};
+#define CASE_COUNT  (sizeof(s_cases) / sizeof(s_cases[0]))
+
+#define MAX_WORDS   1023    // lldesc_t::length has 12 bits
+#define OUT_SIZE    (MAX_WORDS * 2 + 16)
+#define SENTINEL    0xA5
+
+static dma_elem_t s_src[MAX_WORDS + 8];
+
+// xorshift, so every run sees the same data
+static uint32_t next_random(void)
+{
+    static uint32_t x = 2463534242u;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+static void run(dma_filter_t filter, size_t words, size_t offset, uint8_t* out)
+{
+    lldesc_t desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.length = words * sizeof(dma_elem_t);
+    desc.size = desc.length;
+    memset(out, SENTINEL, OUT_SIZE);
+    (*filter)(s_src, &desc, out + offset);
+}
+
+static int compare(void)
+{
+    static uint32_t ref_buf[OUT_SIZE / 4 + 1];
+    static uint32_t test_buf[OUT_SIZE / 4 + 1];
+    uint8_t* ref = (uint8_t*) ref_buf;
+    uint8_t* out = (uint8_t*) test_buf;
+    int failures = 0;
+    for (size_t i = 0; i < sizeof(s_src) / sizeof(s_src[0]); i++) {
+        //the unused bytes of the words are set too, the filters have to mask them
+        s_src[i].val = next_random();
+    }
+    for (size_t c = 0; c < CASE_COUNT; c++) {
+        const filter_case_t* fc = &s_cases[c];
+        int before = failures;
+        for (size_t words = 8; words <= MAX_WORDS; words++) {
+            //aligned destinations for the word filter, every alignment for the byte-wise one
+            for (size_t offset = 0; offset < 4; offset++) {
+                run(fc->ref, words, offset, ref);
+                if (offset == 0) {
+                    run(fc->word, words, offset, out);
+                    if (memcmp(ref, out, OUT_SIZE)) {
+                        printf("  %s: differs at %zu words\n", fc->name, words);
+                        failures++;
+                        break;
+                    }
+                }
+                run(fc->bytes, words, offset, out);
+                if (memcmp(ref, out, OUT_SIZE)) {
+                    printf("  %s_bytes: differs at %zu words, offset %zu\n", fc->name, words, offset);
+                    failures++;
+                    break;
+                }
+            }
+            if (failures != before) {
+                break;
+            }
+        }
+        printf("%s\n  %s\n", fc->name, failures == before ? "ok" : "FAILED");
+    }
+    return failures;
+}
+
+static double time_filter(dma_filter_t filter, uint8_t* out, size_t words, int rounds)
+{
+    lldesc_t desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.length = words * sizeof(dma_elem_t);
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < rounds; i++) {
+        (*filter)(s_src, &desc, out);
+        __asm__ volatile("" ::: "memory");
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+    return ns / rounds / desc.length;
+}
+
+static void bench(void)
+{
+    static uint32_t out_buf[OUT_SIZE / 4 + 1];
+    uint8_t* out = (uint8_t*) out_buf;
+    const size_t words = 1000;
+    const int rounds = 20000;
+    printf("\nns per DMA byte, %zu byte buffers\n", words * sizeof(dma_elem_t));
+    printf("%-22s %10s %10s %10s\n", "filter", "reference", "word", "bytes");
+    for (size_t c = 0; c < CASE_COUNT; c++) {
+        const filter_case_t* fc = &s_cases[c];
+        double ref = time_filter(fc->ref, out, words, rounds);
+        double word = time_filter(fc->word, out, words, rounds);
+        double bytes = time_filter(fc->bytes, out + 1, words, rounds);
+        printf("%-22s %10.3f %10.3f %10.3f\n", fc->name, ref, word, bytes);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int failures = compare();
+    printf("%d failure(s)\n", failures);
+    if (argc > 1 && !strcmp(argv[1], "bench")) {
+        bench();
+    }
+    return failures ? 1 : 0;
+}
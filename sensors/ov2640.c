@@ -10,6 +10,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "sccb.h"
+#include "reg_cache.h"
 #include "ov2640.h"
 #include "ov2640_regs.h"
 #include "ov2640_settings.h"
@@ -23,6 +24,9 @@
 static const char* TAG = "ov2640";
 #endif
 
+//register cache key, the banks share addresses
+#define REG_KEY(bank, reg)  (((bank) << 8) | (reg))
+
 static volatile ov2640_bank_t reg_bank = BANK_MAX;
 static int set_bank(sensor_t *sensor, ov2640_bank_t bank)
 {
@@ -34,6 +38,34 @@ static int set_bank(sensor_t *sensor, ov2640_bank_t bank)
     return res;
 }
 
+static int write_reg(sensor_t *sensor, ov2640_bank_t bank, uint8_t reg, uint8_t value)
+{
+    uint16_t key = REG_KEY(bank, reg);
+    if (bank < BANK_MAX && reg_cache_match(sensor->slv_addr, key, &value, 1)) {
+        return 0;
+    }
+    if (key == REG_KEY(BANK_SENSOR, COM7)) {
+        //a new sensor resolution reloads the sensor timing registers
+        uint8_t com7;
+        if (!reg_cache_get(sensor->slv_addr, key, &com7) || com7 != value) {
+            reg_cache_clear(sensor->slv_addr);
+        }
+    }
+    int ret = set_bank(sensor, bank);
+    if(!ret) {
+        ret = SCCB_Write(sensor->slv_addr, reg, value);
+    }
+    if(!ret && bank < BANK_MAX) {
+        reg_cache_set(sensor->slv_addr, key, value);
+    }
+    if(!ret && key == REG_KEY(BANK_DSP, RESET) && value) {
+        //the DSP blocks that were reset are back to their defaults, and
+        //set_pixformat() after a resolution change has to send its table again
+        reg_cache_clear_range(sensor->slv_addr, REG_KEY(BANK_DSP, 0x00), REG_KEY(BANK_DSP, 0xFF));
+    }
+    return ret;
+}
+
 static int write_regs(sensor_t *sensor, const uint8_t (*regs)[2])
 {
     int i=0, res = 0;
@@ -41,7 +73,7 @@ static int write_regs(sensor_t *sensor, const uint8_t (*regs)[2])
         if (regs[i][0] == BANK_SEL) {
             res = set_bank(sensor, regs[i][1]);
         } else {
-            res = SCCB_Write(sensor->slv_addr, regs[i][0], regs[i][1]);
+            res = write_reg(sensor, reg_bank, regs[i][0], regs[i][1]);
         }
         if (res) {
             return res;
@@ -51,32 +83,29 @@ static int write_regs(sensor_t *sensor, const uint8_t (*regs)[2])
     return res;
 }
 
-static int write_reg(sensor_t *sensor, ov2640_bank_t bank, uint8_t reg, uint8_t value)
-{
-    int ret = set_bank(sensor, bank);
-    if(!ret) {
-        ret = SCCB_Write(sensor->slv_addr, reg, value);
-    }
-    return ret;
-}
-
 static int set_reg_bits(sensor_t *sensor, uint8_t bank, uint8_t reg, uint8_t offset, uint8_t mask, uint8_t value)
 {
     int ret = 0;
     uint8_t c_value, new_value;
 
-    ret = set_bank(sensor, bank);
-    if(ret) {
-        return ret;
+    if (!reg_cache_get(sensor->slv_addr, REG_KEY(bank, reg), &c_value)) {
+        ret = set_bank(sensor, bank);
+        if(ret) {
+            return ret;
+        }
+        c_value = SCCB_Read(sensor->slv_addr, reg);
     }
-    c_value = SCCB_Read(sensor->slv_addr, reg);
     new_value = (c_value & ~(mask << offset)) | ((value & mask) << offset);
-    ret = SCCB_Write(sensor->slv_addr, reg, new_value);
+    ret = write_reg(sensor, bank, reg, new_value);
     return ret;
 }
 
 static int read_reg(sensor_t *sensor, ov2640_bank_t bank, uint8_t reg)
 {
+    uint8_t value;
+    if (reg_cache_get(sensor->slv_addr, REG_KEY(bank, reg), &value)) {
+        return value;
+    }
     if(set_bank(sensor, bank)){
         return 0;
     }
@@ -524,8 +553,35 @@ static int init_status(sensor_t *sensor){
     return 0;
 }
 
+//divide the sensor clock on top of the divider set by the framesize tables
+static int set_frame_divider(sensor_t *sensor, int divider)
+{
+    int clkrc = read_reg(sensor, BANK_SENSOR, CLKRC);
+    int div = ((clkrc & 0x3F) + 1) * divider;
+    if (divider < 1 || div > 64) {
+        return -1;
+    }
+    int ret = write_reg(sensor, BANK_SENSOR, CLKRC, (clkrc & 0xC0) | (div - 1));
+    if (ret == 0) {
+        ESP_LOGD(TAG, "Set frame divider to: %d (CLKRC 0x%02x)", divider, (clkrc & 0xC0) | (div - 1));
+    }
+    return ret;
+}
+
+//registers the sensor changes on its own or that start an action, never cached
+static const reg_cache_range_t uncached_regs[] = {
+    {REG_KEY(BANK_DSP, BPADDR), REG_KEY(BANK_DSP, BPDATA)},     // indirect SDE registers
+    {REG_KEY(BANK_DSP, RESET), REG_KEY(BANK_DSP, RESET)},
+    {REG_KEY(BANK_SENSOR, GAIN), REG_KEY(BANK_SENSOR, GAIN)},   // AGC readback
+    {REG_KEY(BANK_SENSOR, REG04), REG_KEY(BANK_SENSOR, REG04)}, // AEC[1:0] readback
+    {REG_KEY(BANK_SENSOR, AEC), REG_KEY(BANK_SENSOR, AEC)},
+    {REG_KEY(BANK_SENSOR, REG45), REG_KEY(BANK_SENSOR, REG45)},
+};
+
 int ov2640_init(sensor_t *sensor)
 {
+    reg_cache_init(sensor->slv_addr, uncached_regs, sizeof(uncached_regs) / sizeof(uncached_regs[0]), REG_KEY(BANK_SENSOR, COM7), COM7_SRST);
+
     sensor->reset = reset;
     sensor->init_status = init_status;
     sensor->set_pixformat = set_pixformat;
@@ -558,6 +614,7 @@ int ov2640_init(sensor_t *sensor)
 
     sensor->set_raw_gma = set_raw_gma_dsp;
     sensor->set_lenc = set_lenc_dsp;
+    sensor->set_frame_divider = set_frame_divider;
 
     //not supported
     sensor->set_sharpness = set_sharpness;
@@ -10,6 +10,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "sccb.h"
+#include "reg_cache.h"
 #include "ov3660.h"
 #include "ov3660_regs.h"
 #include "ov3660_settings.h"
@@ -26,6 +27,10 @@ static const char *TAG = "ov3660";
 //#define REG_DEBUG_ON
 
 static int read_reg(uint8_t slv_addr, const uint16_t reg){
+    uint8_t value;
+    if (reg_cache_get(slv_addr, reg, &value)) {
+        return value;
+    }
     int ret = SCCB_Read16(slv_addr, reg);
 #ifdef REG_DEBUG_ON
     if (ret < 0) {
@@ -58,6 +63,9 @@ static int read_reg16(uint8_t slv_addr, const uint16_t reg){
 static int write_reg(uint8_t slv_addr, const uint16_t reg, uint8_t value){
     int ret = 0;
 #ifndef REG_DEBUG_ON
+    if (reg_cache_match(slv_addr, reg, &value, 1)) {
+        return 0;
+    }
     ret = SCCB_Write16(slv_addr, reg, value);
 #else
     int old_value = read_reg(slv_addr, reg);
@@ -75,6 +83,9 @@ static int write_reg(uint8_t slv_addr, const uint16_t reg, uint8_t value){
         ESP_LOGE(TAG, "WRITE REG 0x%04x FAILED: %d", reg, ret);
     }
 #endif
+    if (ret == 0) {
+        reg_cache_set(slv_addr, reg, value);
+    }
     return ret;
 }
 
@@ -98,9 +109,30 @@ static int write_regs(uint8_t slv_addr, const uint16_t (*regs)[2])
     while (!ret && regs[i][0] != REGLIST_TAIL) {
         if (regs[i][0] == REG_DLY) {
             vTaskDelay(regs[i][1] / portTICK_PERIOD_MS);
-        } else {
-            ret = write_reg(slv_addr, regs[i][0], regs[i][1]);
+            i++;
+            continue;
+        }
+#ifndef REG_DEBUG_ON
+        //registers at consecutive addresses go out in one transaction
+        uint8_t burst[SCCB_BURST_MAX];
+        int n = 0;
+        do {
+            burst[n] = regs[i + n][1];
+            n++;
+        } while (n < SCCB_BURST_MAX && regs[i + n][0] == regs[i][0] + n && regs[i + n][0] != REG_DLY);
+        if (n > 1) {
+            //a run that differs anywhere is sent whole, the transaction costs more than the bytes
+            if (!reg_cache_match(slv_addr, regs[i][0], burst, n)) {
+                ret = SCCB_WriteBurst16(slv_addr, regs[i][0], burst, n);
+                if (ret == 0) {
+                    reg_cache_set_burst(slv_addr, regs[i][0], burst, n);
+                }
+            }
+            i += n;
+            continue;
         }
+#endif
+        ret = write_reg(slv_addr, regs[i][0], regs[i][1]);
         i++;
     }
     return ret;
@@ -910,8 +942,32 @@ static int init_status(sensor_t *sensor)
     return 0;
 }
 
+//stretch the frame with vertical blanking, the pixel clock stays the same
+static int set_frame_divider(sensor_t *sensor, int divider)
+{
+    int vts = read_reg16(sensor->slv_addr, Y_TOTAL_SIZE_H);
+    if (vts < 0 || divider < 1 || vts * divider > 0xFFFF) {
+        return -1;
+    }
+    int ret = write_reg16(sensor->slv_addr, Y_TOTAL_SIZE_H, vts * divider);
+    if (ret == 0) {
+        ESP_LOGD(TAG, "Set frame divider to: %d (VTS %d)", divider, vts * divider);
+    }
+    return ret;
+}
+
+//registers the sensor changes on its own or that start an action, never cached
+static const reg_cache_range_t uncached_regs[] = {
+    {0x3002, 0x3003},   // block resets
+    {0x3500, 0x3502},   // exposure, read back while AEC runs
+    {0x350a, 0x350b},   // gain, read back while AGC runs
+    {0x3212, 0x3212},   // group hold and launch
+};
+
 int ov3660_init(sensor_t *sensor)
 {
+    reg_cache_init(sensor->slv_addr, uncached_regs, sizeof(uncached_regs) / sizeof(uncached_regs[0]), SYSTEM_CTROL0, 0x80);
+
     sensor->reset = reset;
     sensor->set_pixformat = set_pixformat;
     sensor->set_framesize = set_framesize;
@@ -940,6 +996,7 @@ int ov3660_init(sensor_t *sensor)
     sensor->set_agc_gain = set_agc_gain;
     sensor->set_raw_gma = set_raw_gma_dsp;
     sensor->set_lenc = set_lenc_dsp;
+    sensor->set_frame_divider = set_frame_divider;
     sensor->set_denoise = set_denoise;
     return 0;
 }
@@ -10,9 +10,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include "sccb.h"
+#include "reg_cache.h"
 #include "ov5640.h"
 #include "ov5640_regs.h"
 #include "ov5640_settings.h"
+#include "ov5640_settings_packed.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
@@ -26,6 +28,10 @@ static const char *TAG = "ov5640";
 //#define REG_DEBUG_ON
 
 static int read_reg(uint8_t slv_addr, const uint16_t reg) {
+  uint8_t value;
+  if (reg_cache_get(slv_addr, reg, &value)) {
+    return value;
+  }
   int ret = SCCB_Read16(slv_addr, reg);
 #ifdef REG_DEBUG_ON
   if (ret < 0) {
@@ -58,6 +64,9 @@ static int read_reg16(uint8_t slv_addr, const uint16_t reg) {
 static int write_reg(uint8_t slv_addr, const uint16_t reg, uint8_t value) {
   int ret = 0;
 #ifndef REG_DEBUG_ON
+  if (reg_cache_match(slv_addr, reg, &value, 1)) {
+    return 0;
+  }
   ret = SCCB_Write16(slv_addr, reg, value);
 #else
   int old_value = read_reg(slv_addr, reg);
@@ -75,6 +84,9 @@ static int write_reg(uint8_t slv_addr, const uint16_t reg, uint8_t value) {
     ESP_LOGE(TAG, "WRITE REG 0x%04x FAILED: %d", reg, ret);
   }
 #endif
+  if (ret == 0) {
+    reg_cache_set(slv_addr, reg, value);
+  }
   return ret;
 }
 
@@ -91,20 +103,6 @@ static int set_reg_bits(uint8_t slv_addr, uint16_t reg, uint8_t offset, uint8_t
   return ret;
 }
 
-static int write_regs(uint8_t slv_addr, const uint16_t (*regs)[2])
-{
-  int i = 0, ret = 0;
-  while (!ret && regs[i][0] != REGLIST_TAIL) {
-    if (regs[i][0] == REG_DLY) {
-      vTaskDelay(regs[i][1] / portTICK_PERIOD_MS);
-    } else {
-      ret = write_reg(slv_addr, regs[i][0], regs[i][1]);
-    }
-    i++;
-  }
-  return ret;
-}
-
 static int write_reg16(uint8_t slv_addr, const uint16_t reg, uint16_t value)
 {
   if (write_reg(slv_addr, reg, value >> 8) || write_reg(slv_addr, reg + 1, value)) {
@@ -192,13 +190,13 @@ static int reset(sensor_t *sensor)
     return ret;
   }
   vTaskDelay(100 / portTICK_PERIOD_MS);
-  ret = write_regs(sensor->slv_addr, ov5640_sensor_default_regs);
+  ret = regpack_write(sensor->slv_addr, ov5640_sensor_default_regs_packed);
   if (ret == 0) {
     ESP_LOGD(TAG, "Camera defaults loaded");
     ret = set_ae_level(sensor, 0);
     vTaskDelay(100 / portTICK_PERIOD_MS);
   }
-  ret = write_regs(sensor->slv_addr, ov5640_auto_focus_regs);
+  ret = regpack_write(sensor->slv_addr, ov5640_auto_focus_regs_packed);
   ret != write_reg(sensor->slv_addr, 0x3f00, 0x03);
   if (ret == 0) {
     write_reg(sensor->slv_addr, 0x3025, 0x01);
@@ -211,28 +209,28 @@ static int reset(sensor_t *sensor)
 
 static int set_pixformat(sensor_t *sensor, pixformat_t pixformat) {
   int ret = 0;
-  const uint16_t (*regs)[2];
+  const uint8_t *regs;
 
   switch (pixformat) {
     case PIXFORMAT_YUV422:
-      regs = ov5640_sensor_fmt_yuv422;
+      regs = ov5640_sensor_fmt_yuv422_packed;
       break;
 
     case PIXFORMAT_GRAYSCALE:
-      regs = ov5640_sensor_fmt_grayscale;
+      regs = ov5640_sensor_fmt_grayscale_packed;
       break;
 
     case PIXFORMAT_RGB565:
     case PIXFORMAT_RGB888:
-      regs = ov5640_sensor_fmt_rgb565;
+      regs = ov5640_sensor_fmt_rgb565_packed;
       break;
 
     case PIXFORMAT_JPEG:
-      regs = ov5640_sensor_fmt_jpeg;
+      regs = ov5640_sensor_fmt_jpeg_packed;
       break;
 
     case PIXFORMAT_RAW:
-      regs = ov5640_sensor_fmt_raw;
+      regs = ov5640_sensor_fmt_raw_packed;
       break;
 
     default:
@@ -240,7 +238,7 @@ static int set_pixformat(sensor_t *sensor, pixformat_t pixformat) {
       return -1;
   }
 
-  ret = write_regs(sensor->slv_addr, regs);
+  ret = regpack_write(sensor->slv_addr, regs);
   if (ret == 0) {
     sensor->pixformat = pixformat;
     ESP_LOGD(TAG, "Set pixformat to: %u", pixformat);
@@ -915,8 +913,34 @@ static int init_status(sensor_t *sensor) {
   return 0;
 }
 
+//stretch the frame with vertical blanking, the pixel clock stays the same
+static int set_frame_divider(sensor_t *sensor, int divider)
+{
+  int vts = read_reg16(sensor->slv_addr, Y_TOTAL_SIZE_H);
+  if (vts < 0 || divider < 1 || vts * divider > 0xFFFF) {
+    return -1;
+  }
+  int ret = write_reg16(sensor->slv_addr, Y_TOTAL_SIZE_H, vts * divider);
+  if (ret == 0) {
+    ESP_LOGD(TAG, "Set frame divider to: %d (VTS %d)", divider, vts * divider);
+  }
+  return ret;
+}
+
+//registers the sensor changes on its own or that start an action, never cached
+static const reg_cache_range_t uncached_regs[] = {
+  {0x3002, 0x3003},   // block resets
+  {0x3022, 0x3029},   // auto focus firmware command and status
+  {0x3500, 0x3502},   // exposure, read back while AEC runs
+  {0x350a, 0x350b},   // gain, read back while AGC runs
+  {0x3212, 0x3212},   // group hold and launch
+  {0x8000, 0xffff},   // auto focus firmware
+};
+
 int ov5640_init(sensor_t *sensor)
 {
+  reg_cache_init(sensor->slv_addr, uncached_regs, sizeof(uncached_regs) / sizeof(uncached_regs[0]), SYSTEM_CTROL0, 0x80);
+
   sensor->reset = reset;
   sensor->set_pixformat = set_pixformat;
   sensor->set_framesize = set_framesize;
@@ -945,6 +969,7 @@ int ov5640_init(sensor_t *sensor)
   sensor->set_agc_gain = set_agc_gain;
   sensor->set_raw_gma = set_raw_gma_dsp;
   sensor->set_lenc = set_lenc_dsp;
+  sensor->set_frame_divider = set_frame_divider;
   sensor->set_denoise = set_denoise;
   return 0;
 }
@@ -9,7 +9,10 @@
 #define REG_DLY 0xffff
 #define REGLIST_TAIL 0x0000
 
-const DRAM_ATTR uint16_t ov5640_sensor_default_regs[][2] = {
+// The register lists are played back from ov5640_settings_packed.h, run
+// tools/pack_sensor_regs.py ov5640 after editing them
+
+static const uint16_t ov5640_sensor_default_regs[][2] = {
     { 0x3103, 0x11 }, // Select System input clock from pad clock
     { 0x3008, 0x82 }, // Software Reset
 
@@ -439,7 +442,7 @@ const DRAM_ATTR uint16_t ov5640_sensor_default_regs[][2] = {
 //FORMAT_CTRL00 0x4300
 
 // OV5640 COMPATIBLE ?
-const DRAM_ATTR uint16_t ov5640_sensor_fmt_jpeg[][2] = {
+static const uint16_t ov5640_sensor_fmt_jpeg[][2] = {
   // {FORMAT_CTRL, 0x00}, // YUV422
   // {FORMAT_CTRL00, 0x30}, // YUYV...
   // {0x460C, 0x22}, // 0x20 to 0x02
@@ -457,27 +460,27 @@ const DRAM_ATTR uint16_t ov5640_sensor_fmt_jpeg[][2] = {
 };
 
 // OV5640 COMPATIBLE
-const DRAM_ATTR uint16_t ov5640_sensor_fmt_raw[][2] = {
+static const uint16_t ov5640_sensor_fmt_raw[][2] = {
   // {FORMAT_CTRL00, 0x00}, // RAW
   {REGLIST_TAIL, 0x00}
 };
 
 // OV5640 COMPATIBLE
-const DRAM_ATTR uint16_t ov5640_sensor_fmt_grayscale[][2] = {
+static const uint16_t ov5640_sensor_fmt_grayscale[][2] = {
   // {FORMAT_CTRL, 0x02}, // YUV422
   // {FORMAT_CTRL00, 0x10}, // Y8
   {REGLIST_TAIL, 0x00}
 };
 
 // OV5640 COMPATIBLE
-const DRAM_ATTR uint16_t ov5640_sensor_fmt_yuv422[][2] = {
+static const uint16_t ov5640_sensor_fmt_yuv422[][2] = {
   // {FORMAT_CTRL, 0x02}, // YUV422
   // {FORMAT_CTRL00, 0x30}, // YUYV...
   {REGLIST_TAIL, 0x00}
 };
 
 // OV5640 COMPATIBLE ?
-const DRAM_ATTR uint16_t ov5640_sensor_fmt_rgb565[][2] = {
+static const uint16_t ov5640_sensor_fmt_rgb565[][2] = {
   // {FORMAT_CTRL, 0x01}, // RGB
   // {FORMAT_CTRL00, 0x61}, // RGB565 (BGR)
   {REGLIST_TAIL, 0x00}
@@ -505,7 +508,7 @@ const DRAM_ATTR uint8_t ov5640_sensor_special_effects[7][4] = {
   {0x1e, 0x40, 0xa0, 0x08},//Sepia
 };
 
-const DRAM_ATTR uint16_t ov5640_auto_focus_regs[][2] =
+static const uint16_t ov5640_auto_focus_regs[][2] =
 {
   
 {0x3000,0x20},
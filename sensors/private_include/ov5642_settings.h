@@ -9,7 +9,10 @@
 #define REG_DLY 0xffff
 #define REGLIST_TAIL 0x0000
 
-const DRAM_ATTR uint16_t ov5642_sensor_default_regs[][2] = {
+// The register lists are played back from ov5642_settings_packed.h, run
+// tools/pack_sensor_regs.py ov5642 after editing them
+
+static const uint16_t ov5642_sensor_default_regs[][2] = {
   {SYSTEM_CTROL0, 0x82},  // software reset
   {REG_DLY, 10}, // delay 10ms
 
@@ -772,7 +775,7 @@ const DRAM_ATTR uint16_t ov5642_sensor_default_regs[][2] = {
 //FORMAT_CTRL00 0x4300
 
 // OV5642 COMPATIBLE ?
-const DRAM_ATTR uint16_t ov5642_sensor_fmt_jpeg[][2] = {
+static const uint16_t ov5642_sensor_fmt_jpeg[][2] = {
   {FORMAT_CTRL, 0x00}, // YUV422
   {FORMAT_CTRL00, 0x30}, // YUYV...
   {0x460C, 0x22}, // 0x20 to 0x02
@@ -790,27 +793,27 @@ const DRAM_ATTR uint16_t ov5642_sensor_fmt_jpeg[][2] = {
 };
 
 // OV5642 COMPATIBLE
-const DRAM_ATTR uint16_t ov5642_sensor_fmt_raw[][2] = {
+static const uint16_t ov5642_sensor_fmt_raw[][2] = {
   {FORMAT_CTRL00, 0x00}, // RAW
   {REGLIST_TAIL, 0x00}
 };
 
 // OV5642 COMPATIBLE
-const DRAM_ATTR uint16_t ov5642_sensor_fmt_grayscale[][2] = {
+static const uint16_t ov5642_sensor_fmt_grayscale[][2] = {
   {FORMAT_CTRL, 0x02}, // YUV422
   {FORMAT_CTRL00, 0x10}, // Y8
   {REGLIST_TAIL, 0x00}
 };
 
 // OV5642 COMPATIBLE
-const DRAM_ATTR uint16_t ov5642_sensor_fmt_yuv422[][2] = {
+static const uint16_t ov5642_sensor_fmt_yuv422[][2] = {
   {FORMAT_CTRL, 0x02}, // YUV422
   {FORMAT_CTRL00, 0x30}, // YUYV...
   {REGLIST_TAIL, 0x00}
 };
 
 // OV5642 COMPATIBLE ?
-const DRAM_ATTR uint16_t ov5642_sensor_fmt_rgb565[][2] = {
+static const uint16_t ov5642_sensor_fmt_rgb565[][2] = {
   {FORMAT_CTRL, 0x01}, // RGB
   {FORMAT_CTRL00, 0x61}, // RGB565 (BGR)
   {REGLIST_TAIL, 0x00}
@@ -838,7 +841,7 @@ const DRAM_ATTR uint8_t ov5642_sensor_special_effects[7][4] = {
   {0x1e, 0x40, 0xa0, 0x08},//Sepia
 };
 
-const DRAM_ATTR uint16_t ov5642_auto_focus_regs[][2] =
+static const uint16_t ov5642_auto_focus_regs[][2] =
 {
   {0x3000, 0x20},
   {0x8000, 0x02},
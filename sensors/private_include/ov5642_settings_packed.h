@@ -0,0 +1,742 @@
+/*
+ * Generated by tools/pack_sensor_regs.py from ov5642_settings.h, do not edit.
+ * Played back with regpack_write(), see regpack.h
+ */
+#ifndef _OV5642_SETTINGS_PACKED_H_
+#define _OV5642_SETTINGS_PACKED_H_
+
+#include <stdint.h>
+#include "regpack.h"
+
+// 693 registers in 220 records, 1354 bytes
+static const uint8_t ov5642_sensor_default_regs_packed[] = {
+    0x01, 0x30, 0x08, 0x82,
+    0xff, 0x00, 0x0a,
+    0x01, 0x31, 0x03, 0x93,
+    0x01, 0x30, 0x08, 0x82,
+    0x02, 0x30, 0x17, 0x7f, 0xfc,
+    0x01, 0x38, 0x10, 0xc2,
+    0x01, 0x36, 0x15, 0xf0,
+    0x08, 0x30, 0x00, 0x00, 0x00, 0x5c, 0x00, 0xff, 0xff, 0x43, 0x37,
+    0x01, 0x30, 0x11, 0x04,
+    0x01, 0x30, 0x10, 0x10,
+    0x01, 0x46, 0x0c, 0x22,
+    0x01, 0x38, 0x15, 0x04,
+    0x01, 0x37, 0x0c, 0xa0,
+    0x01, 0x36, 0x02, 0xfc,
+    0x01, 0x36, 0x12, 0xff,
+    0x01, 0x36, 0x34, 0xc0,
+    0x01, 0x36, 0x13, 0x00,
+    0x01, 0x36, 0x05, 0x7c,
+    0x02, 0x36, 0x21, 0x09, 0x60,
+    0x01, 0x36, 0x04, 0x40,
+    0x01, 0x36, 0x03, 0xa7,
+    0x01, 0x36, 0x03, 0x27,
+    0x01, 0x40, 0x00, 0x21,
+    0x01, 0x40, 0x1d, 0x22,
+    0x01, 0x36, 0x00, 0x54,
+    0x02, 0x36, 0x05, 0x04, 0x3f,
+    0x01, 0x3c, 0x01, 0x80,
+    0x01, 0x50, 0x00, 0x4f,
+    0x01, 0x50, 0x20, 0x04,
+    0x02, 0x51, 0x81, 0x79, 0x00,
+    0x01, 0x51, 0x85, 0x22,
+    0x01, 0x51, 0x97, 0x01,
+    0x01, 0x50, 0x01, 0xff,
+    0x01, 0x55, 0x00, 0x0a,
+    0x02, 0x55, 0x04, 0x00, 0x7f,
+    0x01, 0x50, 0x80, 0x08,
+    0x01, 0x30, 0x0e, 0x18,
+    0x01, 0x46, 0x10, 0x00,
+    0x01, 0x47, 0x1d, 0x05,
+    0x01, 0x47, 0x08, 0x06,
+    0x04, 0x38, 0x08, 0x02, 0x80, 0x01, 0xe0,
+    0x02, 0x38, 0x0e, 0x07, 0xd0,
+    0x01, 0x50, 0x1f, 0x00,
+    0x01, 0x50, 0x00, 0x4f,
+    0x01, 0x43, 0x00, 0x30,
+    0x01, 0x35, 0x03, 0x07,
+    0x02, 0x35, 0x01, 0x73, 0x80,
+    0x01, 0x35, 0x0b, 0x00,
+    0x01, 0x35, 0x03, 0x07,
+    0x01, 0x38, 0x24, 0x11,
+    0x02, 0x35, 0x01, 0x1e, 0x80,
+    0x01, 0x35, 0x0b, 0x7f,
+    0x04, 0x38, 0x0c, 0x0c, 0x80, 0x03, 0xe8,
+    0x02, 0x3a, 0x0d, 0x04, 0x03,
+    0x01, 0x38, 0x18, 0xc1,
+    0x01, 0x37, 0x05, 0xdb,
+    0x01, 0x37, 0x0a, 0x81,
+    0x01, 0x38, 0x01, 0x80,
+    0x01, 0x36, 0x21, 0x87,
+    0x01, 0x38, 0x01, 0x50,
+    0x01, 0x38, 0x03, 0x08,
+    0x01, 0x38, 0x27, 0x08,
+    0x01, 0x38, 0x10, 0x40,
+    0x02, 0x38, 0x04, 0x05, 0x00,
+    0x02, 0x56, 0x82, 0x05, 0x00,
+    0x02, 0x38, 0x06, 0x03, 0xc0,
+    0x02, 0x56, 0x86, 0x03, 0xbc,
+    0x01, 0x3a, 0x00, 0x78,
+    0x01, 0x3a, 0x1a, 0x05,
+    0x01, 0x3a, 0x13, 0x30,
+    0x02, 0x3a, 0x18, 0x00, 0x7c,
+    0x04, 0x3a, 0x08, 0x12, 0xc0, 0x0f, 0xa0,
+    0x02, 0x35, 0x0c, 0x07, 0xd0,
+    0x03, 0x35, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x35, 0x0a, 0x00, 0x00,
+    0x01, 0x35, 0x03, 0x00,
+    0x07, 0x52, 0x8a, 0x02, 0x04, 0x08, 0x08, 0x08, 0x10, 0x10,
+    0x0e, 0x52, 0x92, 0x00, 0x02, 0x00, 0x02, 0x00, 0x02, 0x00, 0x02, 0x00, 0x02, 0x00, 0x02, 0x00,
+    0x02,
+    0x01, 0x30, 0x30, 0x0b,
+    0x03, 0x3a, 0x02, 0x00, 0x7d, 0x00,
+    0x03, 0x3a, 0x14, 0x00, 0x7d, 0x00,
+    0x01, 0x3a, 0x00, 0x78,
+    0x04, 0x3a, 0x08, 0x09, 0x60, 0x07, 0xd0,
+    0x02, 0x3a, 0x0d, 0x08, 0x06,
+    0x01, 0x51, 0x93, 0x70,
+    0x01, 0x58, 0x9b, 0x04,
+    0x01, 0x58, 0x9a, 0xc5,
+    0x01, 0x40, 0x1e, 0x20,
+    0x01, 0x40, 0x01, 0x42,
+    0x01, 0x40, 0x1c, 0x04,
+    0x07, 0x52, 0x8a, 0x01, 0x04, 0x08, 0x10, 0x20, 0x28, 0x30,
+    0x0e, 0x52, 0x92, 0x00, 0x01, 0x00, 0x04, 0x00, 0x08, 0x00, 0x10, 0x00, 0x20, 0x00, 0x28, 0x00,
+    0x30,
+    0x01, 0x52, 0x82, 0x00,
+    0x04, 0x53, 0x00, 0x00, 0x20, 0x00, 0x7c,
+    0x06, 0x53, 0x0c, 0x00, 0x0c, 0x20, 0x80, 0x20, 0x80,
+    0x02, 0x53, 0x08, 0x20, 0x40,
+    0x04, 0x53, 0x04, 0x00, 0x30, 0x00, 0x80,
+    0x02, 0x53, 0x14, 0x08, 0x20,
+    0x01, 0x53, 0x19, 0x30,
+    0x03, 0x53, 0x16, 0x10, 0x00, 0x02,
+    0x02, 0x54, 0x02, 0x3f, 0x00,
+    0x01, 0x34, 0x06, 0x00,
+    0x1f, 0x51, 0x80, 0xff, 0x52, 0x11, 0x14, 0x25, 0x24, 0x06, 0x08, 0x08, 0x7c, 0x60, 0xb2, 0xb2,
+    0x44, 0x3d, 0x58, 0x46, 0xf8, 0x04, 0x70, 0xf0, 0xf0, 0x03, 0x01, 0x04, 0x12, 0x04, 0x00, 0x06,
+    0x82, 0x00,
+    0x01, 0x50, 0x25, 0x80,
+    0x02, 0x55, 0x83, 0x40, 0x40,
+    0x01, 0x55, 0x80, 0x02,
+    0x01, 0x50, 0x00, 0xcf,
+    0x01, 0x37, 0x10, 0x10,
+    0x01, 0x36, 0x32, 0x51,
+    0x03, 0x37, 0x02, 0x10, 0xb2, 0x18,
+    0x01, 0x37, 0x0b, 0x40,
+    0x01, 0x37, 0x0d, 0x03,
+    0x02, 0x36, 0x31, 0x01, 0x52,
+    0x01, 0x36, 0x06, 0x24,
+    0x01, 0x36, 0x20, 0x96,
+    0x01, 0x57, 0x85, 0x07,
+    0x01, 0x3a, 0x13, 0x30,
+    0x01, 0x36, 0x00, 0x52,
+    0x01, 0x36, 0x04, 0x48,
+    0x01, 0x36, 0x06, 0x1b,
+    0x01, 0x37, 0x0d, 0x0b,
+    0x01, 0x37, 0x0f, 0xc0,
+    0x01, 0x37, 0x09, 0x01,
+    0x01, 0x38, 0x23, 0x00,
+    0x01, 0x50, 0x07, 0x00,
+    0x01, 0x50, 0x09, 0x00,
+    0x01, 0x50, 0x11, 0x00,
+    0x01, 0x50, 0x13, 0x00,
+    0x01, 0x51, 0x9e, 0x00,
+    0x04, 0x50, 0x86, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x30, 0x2b, 0x00,
+    0x04, 0x38, 0x08, 0x01, 0x40, 0x00, 0xf0,
+    0x01, 0x3a, 0x00, 0x78,
+    0x01, 0x50, 0x01, 0xff,
+    0x02, 0x55, 0x83, 0x50, 0x50,
+    0x01, 0x55, 0x80, 0x02,
+    0x01, 0x3c, 0x01, 0x80,
+    0x01, 0x3c, 0x00, 0x04,
+    0x40, 0x58, 0x00, 0x48, 0x31, 0x21, 0x1b, 0x1a, 0x1e, 0x29, 0x38, 0x26, 0x17, 0x11, 0x0e, 0x0d,
+    0x0e, 0x13, 0x1a, 0x15, 0x0d, 0x08, 0x05, 0x04, 0x05, 0x09, 0x0d, 0x11, 0x0a, 0x04, 0x00, 0x00,
+    0x01, 0x06, 0x09, 0x12, 0x0b, 0x04, 0x00, 0x00, 0x01, 0x06, 0x0a, 0x17, 0x0f, 0x09, 0x06, 0x05,
+    0x06, 0x0a, 0x0e, 0x28, 0x1a, 0x11, 0x0e, 0x0e, 0x0f, 0x15, 0x1d, 0x6e, 0x39, 0x27, 0x1f, 0x1e,
+    0x23, 0x2f, 0x41,
+    0x40, 0x58, 0x40, 0x0e, 0x0c, 0x0d, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0d, 0x0e, 0x0e, 0x0a, 0x0e,
+    0x0e, 0x10, 0x10, 0x11, 0x0a, 0x0f, 0x0e, 0x10, 0x10, 0x10, 0x0a, 0x0e, 0x0e, 0x0f, 0x0f, 0x0f,
+    0x0a, 0x09, 0x0d, 0x0c, 0x0b, 0x0d, 0x07, 0x17, 0x14, 0x18, 0x18, 0x16, 0x12, 0x1b, 0x1a, 0x16,
+    0x16, 0x18, 0x1f, 0x1c, 0x16, 0x10, 0x0f, 0x13, 0x1c, 0x1e, 0x17, 0x11, 0x11, 0x14, 0x1e, 0x1c,
+    0x1c, 0x1a, 0x1a,
+    0x08, 0x58, 0x80, 0x1b, 0x1f, 0x14, 0x1a, 0x1d, 0x1e, 0x1a, 0x1a,
+    0x1f, 0x51, 0x80, 0xff, 0x52, 0x11, 0x14, 0x25, 0x24, 0x14, 0x14, 0x14, 0x69, 0x60, 0xa2, 0x9c,
+    0x36, 0x34, 0x54, 0x4c, 0xf8, 0x04, 0x70, 0xf0, 0xf0, 0x03, 0x01, 0x05, 0x2f, 0x04, 0x00, 0x06,
+    0xa0, 0xa0,
+    0x07, 0x52, 0x8a, 0x00, 0x01, 0x04, 0x08, 0x10, 0x20, 0x30,
+    0x0e, 0x52, 0x92, 0x00, 0x00, 0x00, 0x01, 0x00, 0x04, 0x00, 0x08, 0x00, 0x10, 0x00, 0x20, 0x00,
+    0x30,
+    0x01, 0x52, 0x82, 0x00,
+    0x04, 0x53, 0x00, 0x00, 0x20, 0x00, 0x7c,
+    0x06, 0x53, 0x0c, 0x00, 0x10, 0x20, 0x80, 0x20, 0x80,
+    0x02, 0x53, 0x08, 0x20, 0x40,
+    0x04, 0x53, 0x04, 0x00, 0x30, 0x00, 0x80,
+    0x02, 0x53, 0x14, 0x08, 0x20,
+    0x01, 0x53, 0x19, 0x30,
+    0x03, 0x53, 0x16, 0x10, 0x00, 0x02,
+    0x15, 0x53, 0x80, 0x01, 0x00, 0x00, 0x1f, 0x00, 0x06, 0x00, 0x00, 0x00, 0xe1, 0x00, 0x2b, 0x00,
+    0x00, 0x00, 0x10, 0x00, 0xb3, 0x00, 0xa6, 0x08,
+    0x38, 0x54, 0x80, 0x0c, 0x18, 0x2f, 0x55, 0x64, 0x71, 0x7d, 0x87, 0x91, 0x9a, 0xaa, 0xb8, 0xcd,
+    0xdd, 0xea, 0x1d, 0x05, 0x00, 0x04, 0x20, 0x03, 0x60, 0x02, 0xb8, 0x02, 0x86, 0x02, 0x5b, 0x02,
+    0x3b, 0x02, 0x1c, 0x02, 0x04, 0x01, 0xed, 0x01, 0xc5, 0x01, 0xa5, 0x01, 0x6c, 0x01, 0x41, 0x01,
+    0x20, 0x00, 0x16, 0x01, 0x20, 0x00, 0x10, 0x00, 0xf0, 0x00, 0xdf,
+    0x02, 0x54, 0x02, 0x3f, 0x00,
+    0x01, 0x55, 0x00, 0x10,
+    0x04, 0x55, 0x02, 0x00, 0x06, 0x00, 0x7f,
+    0x01, 0x50, 0x25, 0x80,
+    0x02, 0x3a, 0x0f, 0x30, 0x28,
+    0x01, 0x3a, 0x1b, 0x30,
+    0x01, 0x3a, 0x1e, 0x28,
+    0x01, 0x3a, 0x11, 0x61,
+    0x01, 0x3a, 0x1f, 0x10,
+    0x08, 0x56, 0x88, 0xfd, 0xdf, 0xfe, 0xef, 0xfe, 0xef, 0xaa, 0xaa,
+    0x01, 0x35, 0x03, 0x07,
+    0x04, 0x30, 0x00, 0x7b, 0xff, 0xff, 0x07,
+    0x08, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0xdf, 0xff, 0xff, 0x3f,
+    0x01, 0x30, 0x2c, 0xc2,
+    0x01, 0x47, 0x40, 0x21,
+    0x02, 0x35, 0x0c, 0x07, 0xd0,
+    0x01, 0x36, 0x02, 0xe4,
+    0x02, 0x36, 0x12, 0xac, 0x44,
+    0x03, 0x36, 0x21, 0x27, 0x08, 0x22,
+    0x01, 0x36, 0x04, 0x60,
+    0x01, 0x37, 0x05, 0xda,
+    0x01, 0x37, 0x0a, 0x80,
+    0x01, 0x38, 0x01, 0x8a,
+    0x0e, 0x38, 0x03, 0x0a, 0x0a, 0x20, 0x07, 0x98, 0x0a, 0x20, 0x07, 0x98, 0x0c, 0x80, 0x07, 0xd0,
+    0xc2,
+    0x01, 0x38, 0x15, 0x44,
+    0x01, 0x38, 0x18, 0xc8,
+    0x01, 0x38, 0x24, 0x01,
+    0x01, 0x38, 0x27, 0x0a,
+    0x01, 0x3a, 0x00, 0x78,
+    0x02, 0x3a, 0x0d, 0x10, 0x0d,
+    0x01, 0x3a, 0x10, 0x32,
+    0x01, 0x3a, 0x1b, 0x3c,
+    0x01, 0x3a, 0x1e, 0x32,
+    0x01, 0x3a, 0x11, 0x80,
+    0x01, 0x3a, 0x1f, 0x20,
+    0x01, 0x3a, 0x00, 0x78,
+    0x01, 0x46, 0x0b, 0x35,
+    0x01, 0x47, 0x1d, 0x00,
+    0x01, 0x47, 0x13, 0x03,
+    0x01, 0x47, 0x1c, 0x50,
+    0x02, 0x56, 0x82, 0x0a, 0x20,
+    0x02, 0x56, 0x86, 0x07, 0x98,
+    0x01, 0x50, 0x01, 0x4f,
+    0x01, 0x58, 0x9b, 0x00,
+    0x01, 0x58, 0x9a, 0xc0,
+    0x01, 0x44, 0x07, 0x08,
+    0x01, 0x58, 0x9b, 0x00,
+    0x01, 0x58, 0x9a, 0xc0,
+    0x01, 0x30, 0x02, 0x0c,
+    0x01, 0x30, 0x02, 0x00,
+    0x01, 0x35, 0x03, 0x00,
+    0x01, 0x50, 0x25, 0x80,
+    0x02, 0x3a, 0x0f, 0x48, 0x40,
+    0x01, 0x3a, 0x1b, 0x4a,
+    0x01, 0x3a, 0x1e, 0x3e,
+    0x01, 0x3a, 0x11, 0x70,
+    0x01, 0x3a, 0x1f, 0x20,
+    0x10, 0x38, 0x00, 0x01, 0xb0, 0x00, 0x0a, 0x0a, 0x20, 0x07, 0x98, 0x0a, 0x20, 0x07, 0x98, 0x0c,
+    0x80, 0x07, 0xd0,
+    0x01, 0x50, 0x01, 0x7f,
+    0x08, 0x56, 0x80, 0x00, 0x00, 0x0a, 0x20, 0x00, 0x00, 0x07, 0x98,
+    0x01, 0x44, 0x07, 0x02,
+    0x01, 0x47, 0x1b, 0x02,
+    0x01, 0x38, 0x18, 0xa8,
+    0x01, 0x36, 0x21, 0x10,
+    0x01, 0x38, 0x01, 0xb0,
+    0x01, 0x44, 0x07, 0x0c,
+    0x00,
+};
+
+// 13 registers in 12 records, 50 bytes
+static const uint8_t ov5642_sensor_fmt_jpeg_packed[] = {
+    0x01, 0x50, 0x1f, 0x00,
+    0x01, 0x43, 0x00, 0x30,
+    0x01, 0x46, 0x0c, 0x22,
+    0x01, 0x46, 0x0b, 0x35,
+    0x01, 0x47, 0x1d, 0x00,
+    0x01, 0x30, 0x02, 0x0c,
+    0x01, 0x30, 0x02, 0x00,
+    0x01, 0x47, 0x13, 0x03,
+    0x01, 0x47, 0x1c, 0x50,
+    0x01, 0x38, 0x15, 0x44,
+    0x01, 0x38, 0x18, 0x08,
+    0x02, 0x30, 0x06, 0xff, 0x3f,
+    0x00,
+};
+
+// 1 registers in 1 records, 5 bytes
+static const uint8_t ov5642_sensor_fmt_raw_packed[] = {
+    0x01, 0x43, 0x00, 0x00,
+    0x00,
+};
+
+// 2 registers in 2 records, 9 bytes
+static const uint8_t ov5642_sensor_fmt_grayscale_packed[] = {
+    0x01, 0x50, 0x1f, 0x02,
+    0x01, 0x43, 0x00, 0x10,
+    0x00,
+};
+
+// 2 registers in 2 records, 9 bytes
+static const uint8_t ov5642_sensor_fmt_yuv422_packed[] = {
+    0x01, 0x50, 0x1f, 0x02,
+    0x01, 0x43, 0x00, 0x30,
+    0x00,
+};
+
+// 2 registers in 2 records, 9 bytes
+static const uint8_t ov5642_sensor_fmt_rgb565_packed[] = {
+    0x01, 0x50, 0x1f, 0x01,
+    0x01, 0x43, 0x00, 0x61,
+    0x00,
+};
+
+// 5516 registers in 92 records, 5793 bytes
+static const uint8_t ov5642_auto_focus_regs_packed[] = {
+    0x01, 0x30, 0x00, 0x20,
+    0x40, 0x80, 0x00, 0x02, 0x00, 0x06, 0x02, 0x0b, 0x44, 0x78, 0x7f, 0xe4, 0xf6, 0xd8, 0xfd, 0x75,
+    0x81, 0x7d, 0x02, 0x13, 0xb6, 0x00, 0x02, 0x12, 0xe1, 0xe0, 0xf5, 0x71, 0xa3, 0xe0, 0xf5, 0x72,
+    0xae, 0x69, 0xe4, 0x85, 0x6a, 0x55, 0x8e, 0x54, 0xf5, 0x53, 0xf5, 0x52, 0xab, 0x55, 0xaa, 0x54,
+    0xa9, 0x53, 0xa8, 0x52, 0xaf, 0x2c, 0xfc, 0xfd, 0xfe, 0x12, 0x08, 0x7f, 0x8f, 0x55, 0x8e, 0x54,
+    0x8d, 0x53, 0x8c,
+    0x40, 0x80, 0x40, 0x52, 0xaf, 0x55, 0xae, 0x54, 0xad, 0x53, 0xac, 0x52, 0x8f, 0x2b, 0x8e, 0x2a,
+    0x8d, 0x29, 0x8c, 0x28, 0xae, 0x6b, 0xe4, 0x85, 0x6c, 0x55, 0x8e, 0x54, 0xf5, 0x53, 0xf5, 0x52,
+    0xab, 0x55, 0xaa, 0x54, 0xa9, 0x53, 0xa8, 0x52, 0xaf, 0x2d, 0xfc, 0xfd, 0xfe, 0x12, 0x08, 0x7f,
+    0x8f, 0x55, 0x8e, 0x54, 0x8d, 0x53, 0x8c, 0x52, 0xe5, 0x2b, 0x25, 0x55, 0xf5, 0x2b, 0xe5, 0x2a,
+    0x35, 0x54, 0xf5,
+    0x40, 0x80, 0x80, 0x2a, 0xe5, 0x29, 0x35, 0x53, 0xf5, 0x29, 0xe5, 0x28, 0x35, 0x52, 0xf5, 0x28,
+    0xae, 0x6d, 0xe4, 0x85, 0x6e, 0x55, 0x8e, 0x54, 0xf5, 0x53, 0xf5, 0x52, 0xab, 0x55, 0xaa, 0x54,
+    0xa9, 0x53, 0xa8, 0x52, 0xaf, 0x2e, 0xfc, 0xfd, 0xfe, 0x12, 0x08, 0x7f, 0x8f, 0x55, 0x8e, 0x54,
+    0x8d, 0x53, 0x8c, 0x52, 0xe5, 0x2b, 0x25, 0x55, 0xf5, 0x2b, 0xe5, 0x2a, 0x35, 0x54, 0xf5, 0x2a,
+    0xe5, 0x29, 0x35,
+    0x40, 0x80, 0xc0, 0x53, 0xf5, 0x29, 0xe5, 0x28, 0x35, 0x52, 0xf5, 0x28, 0xae, 0x6f, 0xe4, 0x85,
+    0x70, 0x55, 0x8e, 0x54, 0xf5, 0x53, 0xf5, 0x52, 0xab, 0x55, 0xaa, 0x54, 0xa9, 0x53, 0xa8, 0x52,
+    0xaf, 0x2f, 0xfc, 0xfd, 0xfe, 0x12, 0x08, 0x7f, 0x8f, 0x55, 0x8e, 0x54, 0x8d, 0x53, 0x8c, 0x52,
+    0xe5, 0x2b, 0x25, 0x55, 0xf5, 0x2b, 0xe5, 0x2a, 0x35, 0x54, 0xf5, 0x2a, 0xe5, 0x29, 0x35, 0x53,
+    0xf5, 0x29, 0xe5,
+    0x40, 0x81, 0x00, 0x28, 0x35, 0x52, 0xf5, 0x28, 0xae, 0x71, 0xe4, 0x85, 0x72, 0x55, 0x8e, 0x54,
+    0xf5, 0x53, 0xf5, 0x52, 0xab, 0x55, 0xaa, 0x54, 0xa9, 0x53, 0xa8, 0x52, 0xaf, 0x30, 0xfc, 0xfd,
+    0xfe, 0x12, 0x08, 0x7f, 0x8f, 0x55, 0x8e, 0x54, 0x8d, 0x53, 0x8c, 0x52, 0xe5, 0x2b, 0x25, 0x55,
+    0xf5, 0x2b, 0xe5, 0x2a, 0x35, 0x54, 0xf5, 0x2a, 0xe5, 0x29, 0x35, 0x53, 0xf5, 0x29, 0xe5, 0x28,
+    0x35, 0x52, 0xf5,
+    0x40, 0x81, 0x40, 0x28, 0x22, 0xab, 0x0d, 0xaa, 0x0c, 0xa9, 0x0b, 0xa8, 0x0a, 0xfc, 0xfd, 0xfe,
+    0x12, 0x08, 0x7f, 0x8f, 0x0d, 0x8e, 0x0c, 0x8d, 0x0b, 0x8c, 0x0a, 0x7b, 0x40, 0xe4, 0xfa, 0xf9,
+    0xf8, 0x12, 0x09, 0x0a, 0x8f, 0x0d, 0x8e, 0x0c, 0x8d, 0x0b, 0x8c, 0x0a, 0x22, 0xd2, 0x29, 0x90,
+    0x30, 0x1b, 0xe5, 0x25, 0xf0, 0x22, 0xfe, 0xe4, 0xfc, 0xfd, 0xe5, 0x3f, 0x2f, 0xf5, 0x3f, 0xe5,
+    0x3e, 0x3e, 0xf5,
+    0x40, 0x81, 0x80, 0x3e, 0xed, 0x35, 0x3d, 0xf5, 0x3d, 0xec, 0x35, 0x3c, 0xf5, 0x3c, 0xaf, 0x3f,
+    0xae, 0x3e, 0xfc, 0xad, 0x3d, 0x78, 0x08, 0x12, 0x09, 0xaf, 0x8f, 0x3f, 0x8e, 0x3e, 0x8d, 0x3d,
+    0x8c, 0x3c, 0x22, 0xe5, 0x49, 0x25, 0x7b, 0xf5, 0x82, 0xe4, 0x35, 0x48, 0xf5, 0x83, 0xe4, 0x93,
+    0xff, 0x85, 0x49, 0x82, 0x85, 0x48, 0x83, 0xe4, 0x93, 0xfd, 0xc3, 0xef, 0x9d, 0xff, 0xe4, 0x94,
+    0x00, 0x22, 0xe5,
+    0x40, 0x81, 0xc0, 0x0b, 0x24, 0x01, 0xff, 0xe4, 0x33, 0xfe, 0x22, 0xaf, 0x2b, 0xae, 0x2a, 0xad,
+    0x29, 0xac, 0x28, 0x78, 0x06, 0x12, 0x09, 0x9c, 0x8f, 0x2b, 0x8e, 0x2a, 0x8d, 0x29, 0x8c, 0x28,
+    0xd3, 0xe5, 0x29, 0x94, 0x00, 0xe5, 0x28, 0x94, 0x00, 0x22, 0x12, 0x08, 0x7f, 0x8f, 0x68, 0x8e,
+    0x67, 0x8d, 0x66, 0x8c, 0x65, 0xaf, 0x68, 0xae, 0x67, 0xad, 0x66, 0xac, 0x65, 0x22, 0xe0, 0x44,
+    0x01, 0xf0, 0xe0,
+    0x40, 0x82, 0x00, 0x44, 0x02, 0xf0, 0xe0, 0x44, 0x04, 0xf0, 0x22, 0xd2, 0x09, 0x90, 0x30, 0x18,
+    0xe5, 0x21, 0xf0, 0x22, 0xe4, 0x85, 0x11, 0x0d, 0x85, 0x10, 0x0c, 0xf5, 0x0b, 0xf5, 0x0a, 0xab,
+    0x0d, 0xaa, 0x0c, 0xa9, 0x0b, 0xa8, 0x0a, 0x22, 0x90, 0x30, 0x42, 0xe0, 0xf5, 0x22, 0x75, 0x51,
+    0x0a, 0x22, 0xf5, 0x82, 0xe4, 0x3a, 0xf5, 0x83, 0x02, 0x09, 0xc2, 0x8f, 0x0a, 0x74, 0x4a, 0x2f,
+    0xf8, 0xe6, 0x22,
+    0x40, 0x82, 0x40, 0xc2, 0x07, 0xc2, 0x06, 0xc2, 0x02, 0xc2, 0x01, 0xc2, 0x00, 0xc2, 0x03, 0xd2,
+    0x04, 0x22, 0xf5, 0x82, 0xe4, 0x35, 0x48, 0xf5, 0x83, 0xe4, 0x22, 0x8e, 0x67, 0x8f, 0x68, 0x85,
+    0x68, 0x64, 0xe5, 0x68, 0xae, 0x67, 0x78, 0x06, 0x22, 0xe5, 0x16, 0x25, 0xe0, 0x25, 0xe0, 0x22,
+    0x12, 0x09, 0x0a, 0x8f, 0x68, 0x8e, 0x67, 0x8d, 0x66, 0x8c, 0x65, 0x22, 0xe4, 0x85, 0x0f, 0x0d,
+    0x85, 0x0e, 0x0c,
+    0x40, 0x82, 0x80, 0xf5, 0x0b, 0xf5, 0x0a, 0x22, 0x90, 0x11, 0xdd, 0xe4, 0x93, 0xff, 0x90, 0x30,
+    0x0a, 0xe0, 0x22, 0xc2, 0x02, 0xc2, 0x01, 0xd2, 0x00, 0xc2, 0x03, 0xc2, 0x04, 0x22, 0x85, 0x0e,
+    0x64, 0xe5, 0x0e, 0xae, 0x0d, 0x78, 0x06, 0x22, 0xd2, 0x02, 0xd2, 0x01, 0xc2, 0x00, 0x22, 0xd3,
+    0xe5, 0x68, 0x94, 0xff, 0xe5, 0x67, 0x94, 0x00, 0x22, 0x30, 0x18, 0x50, 0x20, 0x19, 0x4d, 0x75,
+    0x0a, 0x02, 0x74,
+    0x40, 0x82, 0xc0, 0x4a, 0x25, 0x0a, 0xf8, 0xe6, 0xff, 0xe5, 0x4a, 0xd3, 0x9f, 0x40, 0x04, 0x7f,
+    0x00, 0x80, 0x02, 0xaf, 0x0a, 0x12, 0x02, 0x38, 0xff, 0xe5, 0x4b, 0xd3, 0x9f, 0x40, 0x04, 0x7f,
+    0x01, 0x80, 0x02, 0xaf, 0x0a, 0x12, 0x02, 0x38, 0xff, 0xe5, 0x4d, 0xd3, 0x9f, 0x40, 0x04, 0x7f,
+    0x03, 0x80, 0x02, 0xaf, 0x0a, 0x12, 0x02, 0x38, 0xff, 0xe5, 0x4e, 0xd3, 0x9f, 0x40, 0x04, 0x7f,
+    0x04, 0x80, 0x02,
+    0x40, 0x83, 0x00, 0xaf, 0x0a, 0x12, 0x02, 0x38, 0xf5, 0x0b, 0x80, 0x06, 0x85, 0x78, 0x0a, 0x85,
+    0x4f, 0x0b, 0x7f, 0x01, 0xe4, 0xfe, 0x74, 0x4a, 0x25, 0x0a, 0xf8, 0xe6, 0xfd, 0xe5, 0x0b, 0xc3,
+    0x9d, 0x50, 0x04, 0x7d, 0x01, 0x80, 0x02, 0x7d, 0xff, 0xac, 0x0b, 0xe5, 0x4e, 0xb5, 0x0b, 0x03,
+    0xd3, 0x80, 0x01, 0xc3, 0x92, 0x1f, 0xe5, 0x4d, 0xb5, 0x0b, 0x03, 0xd3, 0x80, 0x01, 0xc3, 0x92,
+    0x1e, 0xe5, 0x4c,
+    0x40, 0x83, 0x40, 0xb5, 0x0b, 0x03, 0xd3, 0x80, 0x01, 0xc3, 0x92, 0x1d, 0xe5, 0x4b, 0xb5, 0x0b,
+    0x03, 0xd3, 0x80, 0x01, 0xc3, 0x92, 0x1c, 0xe5, 0x4a, 0xb5, 0x0b, 0x03, 0xd3, 0x80, 0x01, 0xc3,
+    0x92, 0x1b, 0xe5, 0x30, 0xd3, 0x94, 0x00, 0x40, 0x04, 0xa2, 0x1f, 0x80, 0x01, 0xc3, 0x92, 0x1f,
+    0xe5, 0x2f, 0xd3, 0x94, 0x00, 0x40, 0x04, 0xa2, 0x1e, 0x80, 0x01, 0xc3, 0x92, 0x1e, 0xe5, 0x2e,
+    0xd3, 0x94, 0x00,
+    0x40, 0x83, 0x80, 0x40, 0x04, 0xa2, 0x1d, 0x80, 0x01, 0xc3, 0x92, 0x1d, 0xe5, 0x2d, 0xd3, 0x94,
+    0x00, 0x40, 0x04, 0xa2, 0x1c, 0x80, 0x01, 0xc3, 0x92, 0x1c, 0xe5, 0x2c, 0xd3, 0x94, 0x00, 0x40,
+    0x04, 0xa2, 0x1b, 0x80, 0x01, 0xc3, 0x92, 0x1b, 0xe5, 0x23, 0x54, 0xf8, 0x70, 0x43, 0xbf, 0x01,
+    0x08, 0xed, 0xf4, 0x04, 0xfd, 0x7f, 0x02, 0x80, 0x06, 0xbf, 0x02, 0x02, 0x7f, 0x01, 0x0e, 0xd3,
+    0xed, 0x64, 0x80,
+    0x40, 0x83, 0xc0, 0x94, 0x80, 0x40, 0x12, 0xec, 0x2e, 0xf5, 0x0b, 0xc3, 0x95, 0x7b, 0x50, 0x03,
+    0x02, 0x03, 0x28, 0x7d, 0xff, 0xe4, 0xff, 0x80, 0x11, 0xec, 0xd3, 0x9e, 0x50, 0x0b, 0x7d, 0x01,
+    0xe4, 0xff, 0xec, 0x2e, 0xf5, 0x0b, 0x02, 0x03, 0x28, 0xc3, 0xec, 0x9e, 0xf5, 0x0b, 0x02, 0x03,
+    0x28, 0x12, 0x01, 0xbf, 0xe5, 0x4e, 0xb5, 0x07, 0x07, 0xe4, 0xb5, 0x06, 0x03, 0xd3, 0x80, 0x02,
+    0xa2, 0x1f, 0x92,
+    0x40, 0x84, 0x00, 0x1f, 0xe5, 0x4d, 0xb5, 0x07, 0x07, 0xe4, 0xb5, 0x06, 0x03, 0xd3, 0x80, 0x02,
+    0xa2, 0x1e, 0x92, 0x1e, 0x12, 0x01, 0xbf, 0xe5, 0x4c, 0xb5, 0x07, 0x07, 0xe4, 0xb5, 0x06, 0x03,
+    0xd3, 0x80, 0x02, 0xa2, 0x1d, 0x92, 0x1d, 0xe5, 0x4b, 0xb5, 0x07, 0x07, 0xe4, 0xb5, 0x06, 0x03,
+    0xd3, 0x80, 0x02, 0xa2, 0x1c, 0x92, 0x1c, 0x12, 0x01, 0xbf, 0xe5, 0x4a, 0xb5, 0x07, 0x07, 0xe4,
+    0xb5, 0x06, 0x03,
+    0x40, 0x84, 0x40, 0xd3, 0x80, 0x02, 0xa2, 0x1b, 0x92, 0x1b, 0xe5, 0x4e, 0x12, 0x01, 0xc1, 0xad,
+    0x0b, 0x7c, 0x00, 0xef, 0xb5, 0x05, 0x07, 0xec, 0xb5, 0x06, 0x03, 0xd3, 0x80, 0x02, 0xa2, 0x1f,
+    0x92, 0x1f, 0xe5, 0x4d, 0x12, 0x01, 0xc1, 0xef, 0xb5, 0x05, 0x07, 0xee, 0xb5, 0x04, 0x03, 0xd3,
+    0x80, 0x02, 0xa2, 0x1e, 0x92, 0x1e, 0xe5, 0x4c, 0x12, 0x01, 0xc1, 0xad, 0x0b, 0x7c, 0x00, 0xef,
+    0xb5, 0x05, 0x07,
+    0x40, 0x84, 0x80, 0xec, 0xb5, 0x06, 0x03, 0xd3, 0x80, 0x02, 0xa2, 0x1d, 0x92, 0x1d, 0xe5, 0x4b,
+    0x12, 0x01, 0xc1, 0xef, 0xb5, 0x05, 0x07, 0xee, 0xb5, 0x04, 0x03, 0xd3, 0x80, 0x02, 0xa2, 0x1c,
+    0x92, 0x1c, 0xe5, 0x4a, 0x12, 0x01, 0xc1, 0x7c, 0x00, 0xef, 0xb5, 0x0b, 0x07, 0xec, 0xb5, 0x06,
+    0x03, 0xd3, 0x80, 0x02, 0xa2, 0x1b, 0x92, 0x1b, 0xe5, 0x30, 0xd3, 0x94, 0x00, 0x40, 0x04, 0xa2,
+    0x1f, 0x80, 0x01,
+    0x40, 0x84, 0xc0, 0xc3, 0x92, 0x1f, 0xe5, 0x2f, 0xd3, 0x94, 0x00, 0x40, 0x04, 0xa2, 0x1e, 0x80,
+    0x01, 0xc3, 0x92, 0x1e, 0xe5, 0x2e, 0xd3, 0x94, 0x00, 0x40, 0x04, 0xa2, 0x1d, 0x80, 0x01, 0xc3,
+    0x92, 0x1d, 0xe5, 0x2d, 0xd3, 0x94, 0x00, 0x40, 0x04, 0xa2, 0x1c, 0x80, 0x01, 0xc3, 0x92, 0x1c,
+    0xe5, 0x2c, 0xd3, 0x94, 0x00, 0x40, 0x04, 0xa2, 0x1b, 0x80, 0x01, 0xc3, 0x92, 0x1b, 0x85, 0x0a,
+    0x78, 0xe5, 0x7c,
+    0x40, 0x85, 0x00, 0xb5, 0x0b, 0x03, 0x02, 0x15, 0x18, 0x85, 0x0b, 0x0c, 0x12, 0x0f, 0x11, 0xd2,
+    0x02, 0xc2, 0x01, 0xd2, 0x00, 0x75, 0x31, 0x03, 0x22, 0xe5, 0x7d, 0x24, 0xfe, 0x60, 0x27, 0x14,
+    0x60, 0x31, 0x24, 0xf8, 0x60, 0x3a, 0x14, 0x60, 0x4b, 0x14, 0x60, 0x59, 0x14, 0x60, 0x6a, 0x24,
+    0xfd, 0x70, 0x03, 0x02, 0x05, 0xcb, 0x24, 0x10, 0x60, 0x03, 0x02, 0x06, 0xc6, 0xe4, 0xf5, 0x0a,
+    0x12, 0x10, 0xb5,
+    0x40, 0x85, 0x40, 0x02, 0x06, 0xaf, 0x75, 0x0a, 0x01, 0x12, 0x06, 0xc7, 0xc2, 0x3a, 0xd2, 0x39,
+    0x02, 0x06, 0xc0, 0x75, 0x0a, 0x02, 0x12, 0x06, 0xc7, 0xd2, 0x3a, 0xc2, 0x39, 0x02, 0x06, 0xc0,
+    0x30, 0x36, 0x0c, 0x20, 0x3a, 0x03, 0x30, 0x39, 0x06, 0xe4, 0xf5, 0x0a, 0x12, 0x12, 0x92, 0xd2,
+    0x18, 0xc2, 0x19, 0x22, 0x30, 0x36, 0x09, 0x20, 0x3a, 0x03, 0x30, 0x39, 0x03, 0x12, 0x06, 0xd8,
+    0xd2, 0x18, 0xd2,
+    0x40, 0x85, 0x80, 0x19, 0x22, 0x30, 0x36, 0x0c, 0x20, 0x3a, 0x03, 0x30, 0x39, 0x06, 0x75, 0x0a,
+    0x02, 0x12, 0x12, 0x92, 0xc2, 0x18, 0xd2, 0x19, 0x22, 0x20, 0x3a, 0x06, 0x20, 0x39, 0x03, 0x02,
+    0x06, 0xc6, 0xe5, 0x78, 0xd3, 0x94, 0x03, 0x40, 0x04, 0x7f, 0x00, 0x80, 0x04, 0xe5, 0x78, 0x04,
+    0xff, 0x8f, 0x78, 0x30, 0x18, 0x06, 0x30, 0x19, 0x03, 0x12, 0x06, 0xd8, 0x30, 0x18, 0x03, 0x02,
+    0x06, 0xc6, 0x20,
+    0x40, 0x85, 0xc0, 0x19, 0x03, 0x02, 0x06, 0xc6, 0x75, 0x0a, 0x02, 0x02, 0x12, 0x92, 0xe5, 0x67,
+    0xd3, 0x94, 0x38, 0x40, 0x04, 0x7f, 0x34, 0x80, 0x02, 0xaf, 0x67, 0x8f, 0x67, 0xe5, 0x67, 0xc3,
+    0x94, 0x08, 0x50, 0x04, 0x7f, 0x08, 0x80, 0x02, 0xaf, 0x67, 0x8f, 0x67, 0xe5, 0x68, 0xd3, 0x94,
+    0x2a, 0x40, 0x04, 0x7f, 0x2a, 0x80, 0x02, 0xaf, 0x68, 0x8f, 0x68, 0xe5, 0x68, 0xc3, 0x94, 0x06,
+    0x50, 0x04, 0x7f,
+    0x40, 0x86, 0x00, 0x06, 0x80, 0x02, 0xaf, 0x68, 0x8f, 0x68, 0xaf, 0x67, 0xef, 0x24, 0xf8, 0xff,
+    0xe4, 0x34, 0xff, 0xfe, 0xe4, 0x8f, 0x3f, 0x8e, 0x3e, 0xf5, 0x3d, 0xf5, 0x3c, 0xac, 0x3c, 0x12,
+    0x01, 0x90, 0xaf, 0x68, 0xef, 0x24, 0xfa, 0xff, 0xe4, 0x34, 0xff, 0x12, 0x01, 0x73, 0xaf, 0x67,
+    0xef, 0x24, 0x08, 0xff, 0xe4, 0x33, 0x12, 0x01, 0x73, 0xaf, 0x68, 0xef, 0x24, 0x06, 0xff, 0xe4,
+    0x33, 0xfe, 0xe4,
+    0x40, 0x86, 0x40, 0xfc, 0xfd, 0xe5, 0x3f, 0x2f, 0xf5, 0x3f, 0xe5, 0x3e, 0x3e, 0xf5, 0x3e, 0xed,
+    0x35, 0x3d, 0xf5, 0x3d, 0xec, 0x35, 0x3c, 0xf5, 0x3c, 0xe4, 0x25, 0x3f, 0xf5, 0x37, 0xe4, 0x35,
+    0x3e, 0xf5, 0x36, 0xe4, 0x35, 0x3d, 0xf5, 0x35, 0xe5, 0x3c, 0x34, 0x08, 0xf5, 0x34, 0xe4, 0x25,
+    0x3f, 0xf5, 0x3b, 0xe4, 0x35, 0x3e, 0xf5, 0x3a, 0xe5, 0x3d, 0x34, 0x06, 0xf5, 0x39, 0xe4, 0x35,
+    0x3c, 0xf5, 0x38,
+    0x40, 0x86, 0x80, 0xe5, 0x3f, 0x24, 0xfa, 0xf5, 0x43, 0xe5, 0x3e, 0x34, 0xff, 0xf5, 0x42, 0xe5,
+    0x3d, 0x34, 0xff, 0xf5, 0x41, 0xe5, 0x3c, 0x34, 0xff, 0xf5, 0x40, 0xe4, 0x25, 0x3f, 0xf5, 0x47,
+    0xe5, 0x3e, 0x34, 0xf8, 0xf5, 0x46, 0xe5, 0x3d, 0x34, 0xff, 0xf5, 0x45, 0xe5, 0x3c, 0x34, 0xff,
+    0xf5, 0x44, 0x75, 0x78, 0x02, 0x75, 0x0a, 0x01, 0x12, 0x12, 0x92, 0xd2, 0x18, 0xd2, 0x19, 0xc2,
+    0x3a, 0xc2, 0x39,
+    0x40, 0x86, 0xc0, 0xd2, 0x1a, 0xd2, 0x36, 0xd2, 0x30, 0x22, 0x12, 0x10, 0xb5, 0x75, 0x78, 0x02,
+    0xe4, 0xf5, 0x0a, 0x12, 0x12, 0x92, 0xd2, 0x18, 0xc2, 0x19, 0x22, 0x75, 0x0a, 0x01, 0x12, 0x12,
+    0x92, 0x22, 0x90, 0x38, 0x04, 0xe0, 0xfe, 0xa3, 0xe0, 0xfd, 0xed, 0xff, 0xee, 0x54, 0x0f, 0xf5,
+    0x0e, 0x8f, 0x0f, 0xa3, 0xe0, 0xfe, 0xa3, 0xe0, 0xfd, 0xed, 0xff, 0xee, 0x54, 0x07, 0xf5, 0x10,
+    0x8f, 0x11, 0xe5,
+    0x40, 0x87, 0x00, 0x0e, 0xc4, 0xf8, 0x54, 0xf0, 0xc8, 0x68, 0xf5, 0x0e, 0xe5, 0x0f, 0xc4, 0x54,
+    0x0f, 0x48, 0xf5, 0x0f, 0xe5, 0x10, 0xc4, 0xf8, 0x54, 0xf0, 0xc8, 0x68, 0xf5, 0x10, 0xe5, 0x11,
+    0xc4, 0x54, 0x0f, 0x48, 0xf5, 0x11, 0xe4, 0xf5, 0x17, 0x75, 0x16, 0x04, 0x12, 0x02, 0x66, 0x24,
+    0x34, 0xf8, 0xe6, 0xf5, 0x12, 0x12, 0x02, 0x66, 0x24, 0x35, 0xf8, 0xe6, 0xf5, 0x14, 0x12, 0x02,
+    0x66, 0x24, 0x36,
+    0x40, 0x87, 0x40, 0xf8, 0xe6, 0xf5, 0x13, 0x12, 0x02, 0x66, 0x24, 0x37, 0xf8, 0xe6, 0xf5, 0x15,
+    0x12, 0x02, 0x79, 0xaf, 0x12, 0x12, 0x01, 0x42, 0x8f, 0x12, 0x12, 0x02, 0x79, 0xaf, 0x13, 0x12,
+    0x01, 0x42, 0x8f, 0x13, 0x12, 0x02, 0x11, 0xaf, 0x14, 0xfc, 0xfd, 0xfe, 0x12, 0x08, 0x7f, 0x12,
+    0x01, 0x61, 0x7b, 0x30, 0x12, 0x01, 0x5a, 0x8f, 0x14, 0x12, 0x02, 0x11, 0xaf, 0x15, 0xfc, 0xfd,
+    0xfe, 0x12, 0x08,
+    0x40, 0x87, 0x80, 0x7f, 0x12, 0x01, 0x61, 0xe4, 0x7b, 0x30, 0x12, 0x01, 0x5b, 0x8f, 0x15, 0xc3,
+    0xe5, 0x13, 0x95, 0x12, 0xff, 0x0f, 0xef, 0xc3, 0x13, 0xff, 0xc3, 0x94, 0x04, 0x50, 0x27, 0xe5,
+    0x12, 0x9f, 0x40, 0x06, 0xe5, 0x12, 0x9f, 0xfe, 0x80, 0x02, 0x7e, 0x00, 0x8e, 0x12, 0xef, 0xfd,
+    0xe5, 0x13, 0x2d, 0xfd, 0xe4, 0x33, 0xfc, 0xc3, 0xed, 0x95, 0x0f, 0xec, 0x95, 0x0e, 0x50, 0x02,
+    0x80, 0x02, 0xad,
+    0x40, 0x87, 0xc0, 0x0f, 0x8d, 0x13, 0xc3, 0xe5, 0x15, 0x95, 0x14, 0xff, 0xc3, 0x94, 0x04, 0x50,
+    0x29, 0xe5, 0x14, 0x9f, 0x40, 0x06, 0xe5, 0x14, 0x9f, 0xfe, 0x80, 0x02, 0x7e, 0x00, 0x8e, 0x14,
+    0xef, 0xfd, 0xe5, 0x15, 0x2d, 0xfd, 0xe4, 0x33, 0xfc, 0xc3, 0xed, 0x95, 0x11, 0xec, 0x95, 0x10,
+    0x50, 0x04, 0xaf, 0x05, 0x80, 0x02, 0xaf, 0x11, 0x8f, 0x15, 0xe5, 0x15, 0xd3, 0x95, 0x17, 0x40,
+    0x04, 0xaf, 0x15,
+    0x40, 0x88, 0x00, 0x80, 0x02, 0xaf, 0x17, 0x8f, 0x17, 0xd3, 0xe5, 0x16, 0x64, 0x80, 0x94, 0x80,
+    0x40, 0x04, 0xaf, 0x15, 0x80, 0x02, 0xaf, 0x17, 0x8f, 0x15, 0xe5, 0x16, 0xfd, 0x33, 0x95, 0xe0,
+    0xfc, 0xed, 0xae, 0x04, 0x78, 0x02, 0xc3, 0x33, 0xce, 0x33, 0xce, 0xd8, 0xf9, 0xff, 0x24, 0x01,
+    0xfb, 0xee, 0x34, 0x60, 0x8b, 0x82, 0xf5, 0x83, 0xe5, 0x12, 0xf0, 0xef, 0x24, 0x02, 0xff, 0xee,
+    0x34, 0x60, 0x8f,
+    0x40, 0x88, 0x40, 0x82, 0xf5, 0x83, 0xe5, 0x14, 0xf0, 0xed, 0xae, 0x04, 0x78, 0x02, 0xc3, 0x33,
+    0xce, 0x33, 0xce, 0xd8, 0xf9, 0xff, 0x24, 0x03, 0xfd, 0xee, 0x34, 0x60, 0x8d, 0x82, 0xf5, 0x83,
+    0xe5, 0x13, 0xf0, 0xef, 0x24, 0x04, 0xff, 0xee, 0x34, 0x60, 0x8f, 0x82, 0xf5, 0x83, 0xe5, 0x15,
+    0xf0, 0x15, 0x16, 0xc3, 0xe5, 0x16, 0x64, 0x80, 0x94, 0x80, 0x40, 0x03, 0x02, 0x07, 0x29, 0xc2,
+    0x30, 0x22, 0xe8,
+    0x40, 0x88, 0x80, 0x8f, 0xf0, 0xa4, 0xcc, 0x8b, 0xf0, 0xa4, 0x2c, 0xfc, 0xe9, 0x8e, 0xf0, 0xa4,
+    0x2c, 0xfc, 0x8a, 0xf0, 0xed, 0xa4, 0x2c, 0xfc, 0xea, 0x8e, 0xf0, 0xa4, 0xcd, 0xa8, 0xf0, 0x8b,
+    0xf0, 0xa4, 0x2d, 0xcc, 0x38, 0x25, 0xf0, 0xfd, 0xe9, 0x8f, 0xf0, 0xa4, 0x2c, 0xcd, 0x35, 0xf0,
+    0xfc, 0xeb, 0x8e, 0xf0, 0xa4, 0xfe, 0xa9, 0xf0, 0xeb, 0x8f, 0xf0, 0xa4, 0xcf, 0xc5, 0xf0, 0x2e,
+    0xcd, 0x39, 0xfe,
+    0x40, 0x88, 0xc0, 0xe4, 0x3c, 0xfc, 0xea, 0xa4, 0x2d, 0xce, 0x35, 0xf0, 0xfd, 0xe4, 0x3c, 0xfc,
+    0x22, 0x75, 0xf0, 0x08, 0x75, 0x82, 0x00, 0xef, 0x2f, 0xff, 0xee, 0x33, 0xfe, 0xcd, 0x33, 0xcd,
+    0xcc, 0x33, 0xcc, 0xc5, 0x82, 0x33, 0xc5, 0x82, 0x9b, 0xed, 0x9a, 0xec, 0x99, 0xe5, 0x82, 0x98,
+    0x40, 0x0c, 0xf5, 0x82, 0xee, 0x9b, 0xfe, 0xed, 0x9a, 0xfd, 0xec, 0x99, 0xfc, 0x0f, 0xd5, 0xf0,
+    0xd6, 0xe4, 0xce,
+    0x40, 0x89, 0x00, 0xfb, 0xe4, 0xcd, 0xfa, 0xe4, 0xcc, 0xf9, 0xa8, 0x82, 0x22, 0xb8, 0x00, 0xc1,
+    0xb9, 0x00, 0x59, 0xba, 0x00, 0x2d, 0xec, 0x8b, 0xf0, 0x84, 0xcf, 0xce, 0xcd, 0xfc, 0xe5, 0xf0,
+    0xcb, 0xf9, 0x78, 0x18, 0xef, 0x2f, 0xff, 0xee, 0x33, 0xfe, 0xed, 0x33, 0xfd, 0xec, 0x33, 0xfc,
+    0xeb, 0x33, 0xfb, 0x10, 0xd7, 0x03, 0x99, 0x40, 0x04, 0xeb, 0x99, 0xfb, 0x0f, 0xd8, 0xe5, 0xe4,
+    0xf9, 0xfa, 0x22,
+    0x40, 0x89, 0x40, 0x78, 0x18, 0xef, 0x2f, 0xff, 0xee, 0x33, 0xfe, 0xed, 0x33, 0xfd, 0xec, 0x33,
+    0xfc, 0xc9, 0x33, 0xc9, 0x10, 0xd7, 0x05, 0x9b, 0xe9, 0x9a, 0x40, 0x07, 0xec, 0x9b, 0xfc, 0xe9,
+    0x9a, 0xf9, 0x0f, 0xd8, 0xe0, 0xe4, 0xc9, 0xfa, 0xe4, 0xcc, 0xfb, 0x22, 0x75, 0xf0, 0x10, 0xef,
+    0x2f, 0xff, 0xee, 0x33, 0xfe, 0xed, 0x33, 0xfd, 0xcc, 0x33, 0xcc, 0xc8, 0x33, 0xc8, 0x10, 0xd7,
+    0x07, 0x9b, 0xec,
+    0x40, 0x89, 0x80, 0x9a, 0xe8, 0x99, 0x40, 0x0a, 0xed, 0x9b, 0xfd, 0xec, 0x9a, 0xfc, 0xe8, 0x99,
+    0xf8, 0x0f, 0xd5, 0xf0, 0xda, 0xe4, 0xcd, 0xfb, 0xe4, 0xcc, 0xfa, 0xe4, 0xc8, 0xf9, 0x22, 0xe8,
+    0x60, 0x0f, 0xec, 0xc3, 0x13, 0xfc, 0xed, 0x13, 0xfd, 0xee, 0x13, 0xfe, 0xef, 0x13, 0xff, 0xd8,
+    0xf1, 0x22, 0xe8, 0x60, 0x0f, 0xef, 0xc3, 0x33, 0xff, 0xee, 0x33, 0xfe, 0xed, 0x33, 0xfd, 0xec,
+    0x33, 0xfc, 0xd8,
+    0x40, 0x89, 0xc0, 0xf1, 0x22, 0xe4, 0x93, 0xfc, 0x74, 0x01, 0x93, 0xfd, 0x74, 0x02, 0x93, 0xfe,
+    0x74, 0x03, 0x93, 0xff, 0x22, 0xd0, 0x83, 0xd0, 0x82, 0xf8, 0xe4, 0x93, 0x70, 0x12, 0x74, 0x01,
+    0x93, 0x70, 0x0d, 0xa3, 0xa3, 0x93, 0xf8, 0x74, 0x01, 0x93, 0xf5, 0x82, 0x88, 0x83, 0xe4, 0x73,
+    0x74, 0x02, 0x93, 0x68, 0x60, 0xef, 0xa3, 0xa3, 0xa3, 0x80, 0xdf, 0x75, 0x12, 0x0a, 0xa2, 0xaf,
+    0x92, 0x32, 0xc2,
+    0x40, 0x8a, 0x00, 0xaf, 0xc2, 0x33, 0x12, 0x01, 0x6a, 0x12, 0x02, 0x08, 0x12, 0x01, 0x6a, 0x75,
+    0x51, 0x05, 0xaf, 0x51, 0x15, 0x51, 0xef, 0x70, 0xf9, 0xd2, 0x28, 0x12, 0x01, 0x6c, 0x75, 0x51,
+    0x0a, 0xaf, 0x51, 0x15, 0x51, 0xef, 0x70, 0xf9, 0xc2, 0x29, 0x12, 0x01, 0x6c, 0x75, 0x51, 0x05,
+    0xaf, 0x51, 0x15, 0x51, 0xef, 0x70, 0xf9, 0xc2, 0x28, 0x12, 0x01, 0x6c, 0x75, 0x51, 0x05, 0xaf,
+    0x51, 0x15, 0x51,
+    0x40, 0x8a, 0x40, 0xef, 0x70, 0xf9, 0x75, 0x13, 0x18, 0x12, 0x0b, 0x38, 0x75, 0x51, 0x0a, 0xaf,
+    0x51, 0x15, 0x51, 0xef, 0x70, 0xf9, 0xd2, 0x28, 0x12, 0x01, 0x6c, 0x12, 0x02, 0x25, 0xaf, 0x51,
+    0x15, 0x51, 0xef, 0x70, 0xf9, 0xc2, 0x28, 0x12, 0x01, 0x6c, 0x75, 0x51, 0x0a, 0xaf, 0x51, 0x15,
+    0x51, 0xef, 0x70, 0xf9, 0x30, 0x11, 0x03, 0x02, 0x0a, 0xef, 0x12, 0x01, 0x6a, 0x12, 0x02, 0x08,
+    0xe5, 0x10, 0xf5,
+    0x40, 0x8a, 0x80, 0x13, 0x12, 0x0b, 0x38, 0x75, 0x51, 0x0a, 0xaf, 0x51, 0x15, 0x51, 0xef, 0x70,
+    0xf9, 0xd2, 0x28, 0x12, 0x01, 0x6c, 0x12, 0x02, 0x25, 0xaf, 0x51, 0x15, 0x51, 0xef, 0x70, 0xf9,
+    0xc2, 0x28, 0x12, 0x01, 0x6c, 0x75, 0x51, 0x0a, 0xaf, 0x51, 0x15, 0x51, 0xef, 0x70, 0xf9, 0x30,
+    0x11, 0x04, 0x15, 0x12, 0x80, 0x45, 0x12, 0x01, 0x6a, 0x12, 0x02, 0x08, 0x85, 0x11, 0x13, 0x12,
+    0x13, 0x72, 0xc2,
+    0x40, 0x8a, 0xc0, 0x09, 0x12, 0x02, 0x0a, 0x75, 0x51, 0x0a, 0xaf, 0x51, 0x15, 0x51, 0xef, 0x70,
+    0xf9, 0xd2, 0x28, 0x12, 0x01, 0x6c, 0x12, 0x02, 0x25, 0xaf, 0x51, 0x15, 0x51, 0xef, 0x70, 0xf9,
+    0xc2, 0x28, 0x12, 0x01, 0x6c, 0x75, 0x51, 0x0a, 0xaf, 0x51, 0x15, 0x51, 0xef, 0x70, 0xf9, 0x30,
+    0x11, 0x06, 0x15, 0x12, 0xd2, 0x33, 0x80, 0x03, 0xe4, 0xf5, 0x12, 0x12, 0x01, 0x6a, 0x12, 0x02,
+    0x08, 0xc2, 0x29,
+    0x40, 0x8b, 0x00, 0x12, 0x01, 0x6c, 0x75, 0x51, 0x05, 0xaf, 0x51, 0x15, 0x51, 0xef, 0x70, 0xf9,
+    0xd2, 0x28, 0x12, 0x01, 0x6c, 0x75, 0x51, 0x05, 0xaf, 0x51, 0x15, 0x51, 0xef, 0x70, 0xf9, 0x12,
+    0x01, 0x6a, 0x75, 0x51, 0x05, 0xaf, 0x51, 0x15, 0x51, 0xef, 0x70, 0xf9, 0xa2, 0x32, 0x92, 0xaf,
+    0xe5, 0x12, 0xd3, 0x94, 0x00, 0x40, 0x03, 0x02, 0x09, 0xff, 0x22, 0x12, 0x13, 0x72, 0xc2, 0x09,
+    0x90, 0x30, 0x18,
+    0x40, 0x8b, 0x40, 0xe5, 0x21, 0xf0, 0x22, 0xc0, 0xe0, 0xc0, 0xf0, 0xc0, 0x83, 0xc0, 0x82, 0xc0,
+    0xd0, 0x75, 0xd0, 0x00, 0xc0, 0x00, 0xc0, 0x01, 0xc0, 0x02, 0xc0, 0x03, 0xc0, 0x04, 0xc0, 0x05,
+    0xc0, 0x06, 0xc0, 0x07, 0x90, 0x3f, 0x0c, 0xe0, 0xf5, 0x08, 0xe5, 0x08, 0x20, 0xe3, 0x03, 0x02,
+    0x0b, 0xf5, 0x30, 0x35, 0x03, 0x02, 0x0b, 0xf5, 0x90, 0x60, 0x16, 0xe0, 0xf5, 0x69, 0xa3, 0xe0,
+    0xf5, 0x6a, 0x90,
+    0x40, 0x8b, 0x80, 0x60, 0x1e, 0xe0, 0xf5, 0x6b, 0xa3, 0xe0, 0xf5, 0x6c, 0x90, 0x60, 0x26, 0xe0,
+    0xf5, 0x6d, 0xa3, 0xe0, 0xf5, 0x6e, 0x90, 0x60, 0x2e, 0xe0, 0xf5, 0x6f, 0xa3, 0xe0, 0xf5, 0x70,
+    0x90, 0x60, 0x36, 0x12, 0x00, 0x16, 0x12, 0x01, 0xc8, 0x40, 0x06, 0x75, 0x2a, 0xff, 0x75, 0x2b,
+    0xff, 0x85, 0x2a, 0x73, 0x85, 0x2b, 0x74, 0x90, 0x60, 0x1a, 0xe0, 0xf5, 0x69, 0xa3, 0xe0, 0xf5,
+    0x6a, 0x90, 0x60,
+    0x40, 0x8b, 0xc0, 0x22, 0xe0, 0xf5, 0x6b, 0xa3, 0xe0, 0xf5, 0x6c, 0x90, 0x60, 0x2a, 0xe0, 0xf5,
+    0x6d, 0xa3, 0xe0, 0xf5, 0x6e, 0x90, 0x60, 0x32, 0xe0, 0xf5, 0x6f, 0xa3, 0xe0, 0xf5, 0x70, 0x90,
+    0x60, 0x3a, 0x12, 0x00, 0x16, 0x12, 0x01, 0xc8, 0x40, 0x06, 0x75, 0x2a, 0xff, 0x75, 0x2b, 0xff,
+    0x85, 0x2a, 0x75, 0x85, 0x2b, 0x76, 0xd2, 0x3b, 0xe5, 0x08, 0x30, 0xe5, 0x41, 0x90, 0x56, 0x90,
+    0xe0, 0xf5, 0x55,
+    0x40, 0x8c, 0x00, 0xe5, 0x7a, 0x12, 0x01, 0xc1, 0xad, 0x55, 0xc3, 0xef, 0x9d, 0x74, 0x80, 0xf8,
+    0x6e, 0x98, 0x50, 0x02, 0x80, 0x01, 0xc3, 0x92, 0x27, 0xaf, 0x55, 0xef, 0x24, 0x01, 0xff, 0xe4,
+    0x33, 0xfe, 0xc3, 0xef, 0x95, 0x7a, 0x74, 0x80, 0xf8, 0x6e, 0x98, 0x50, 0x02, 0x80, 0x02, 0xa2,
+    0x27, 0x92, 0x27, 0x30, 0x27, 0x04, 0xaf, 0x55, 0x80, 0x02, 0xaf, 0x7a, 0x8f, 0x7a, 0xe5, 0x08,
+    0x30, 0xe1, 0x08,
+    0x40, 0x8c, 0x40, 0x90, 0x30, 0x24, 0xe0, 0xf5, 0x33, 0xe4, 0xf0, 0x90, 0x3f, 0x0c, 0xe5, 0x08,
+    0xf0, 0xd0, 0x07, 0xd0, 0x06, 0xd0, 0x05, 0xd0, 0x04, 0xd0, 0x03, 0xd0, 0x02, 0xd0, 0x01, 0xd0,
+    0x00, 0xd0, 0xd0, 0xd0, 0x82, 0xd0, 0x83, 0xd0, 0xf0, 0xd0, 0xe0, 0x32, 0xe5, 0x33, 0x70, 0x03,
+    0x02, 0x0d, 0x76, 0xc2, 0xaf, 0xaf, 0x33, 0xe4, 0xf5, 0x33, 0xd2, 0xaf, 0x90, 0x30, 0x25, 0xe0,
+    0xf5, 0x7d, 0x90,
+    0x40, 0x8c, 0x80, 0x50, 0x82, 0xe0, 0xf5, 0x65, 0xa3, 0xe0, 0xf5, 0x66, 0xa3, 0xe0, 0xf5, 0x67,
+    0xa3, 0xe0, 0xf5, 0x68, 0xef, 0x12, 0x09, 0xd2, 0x0c, 0xba, 0x03, 0x0c, 0xcf, 0x05, 0x0c, 0xf9,
+    0x06, 0x0c, 0xe7, 0x08, 0x0d, 0x06, 0x10, 0x0d, 0x1a, 0x12, 0x0d, 0x1f, 0x20, 0x0d, 0x2d, 0x21,
+    0x0d, 0x32, 0x30, 0x0d, 0x5b, 0x50, 0x0d, 0x3d, 0xd8, 0x00, 0x00, 0x0d, 0x68, 0x20, 0x05, 0x03,
+    0x02, 0x0d, 0x68,
+    0x40, 0x8c, 0xc0, 0x30, 0x00, 0x03, 0x02, 0x0d, 0x68, 0xd2, 0x07, 0xc2, 0x06, 0x12, 0x02, 0x90,
+    0x80, 0x24, 0x20, 0x05, 0x03, 0x02, 0x0d, 0x68, 0x30, 0x00, 0x03, 0x02, 0x0d, 0x68, 0xc2, 0x07,
+    0xd2, 0x06, 0x12, 0x02, 0xa5, 0xc2, 0x04, 0x02, 0x0d, 0x68, 0x12, 0x02, 0x40, 0x30, 0x05, 0x06,
+    0xe4, 0xf5, 0x0c, 0x12, 0x0f, 0x11, 0xc2, 0x31, 0xd2, 0x34, 0x80, 0x6f, 0x30, 0x07, 0x6c, 0x30,
+    0x06, 0x69, 0x12,
+    0x40, 0x8d, 0x00, 0x02, 0x90, 0xd2, 0x31, 0x80, 0x62, 0x20, 0x07, 0x03, 0x30, 0x06, 0x09, 0xe5,
+    0x7d, 0x64, 0x0e, 0x70, 0x56, 0x20, 0x00, 0x53, 0x12, 0x05, 0x16, 0x80, 0x4e, 0x12, 0x06, 0xdf,
+    0x80, 0x49, 0x30, 0x05, 0x46, 0x20, 0x07, 0x43, 0x20, 0x06, 0x40, 0x12, 0x15, 0x4c, 0x80, 0x3b,
+    0x12, 0x11, 0x7d, 0x80, 0x36, 0x20, 0x07, 0x33, 0x20, 0x06, 0x30, 0x12, 0x15, 0x5b, 0x80, 0x2b,
+    0xe5, 0x7d, 0x64,
+    0x40, 0x8d, 0x40, 0x01, 0x70, 0x25, 0xd2, 0x35, 0x90, 0x50, 0x82, 0xe5, 0x73, 0xf0, 0xa3, 0xe5,
+    0x74, 0xf0, 0xa3, 0xe5, 0x75, 0xf0, 0xa3, 0xe5, 0x76, 0xf0, 0xc2, 0x35, 0x80, 0x0d, 0x90, 0x50,
+    0x82, 0x30, 0x33, 0x05, 0x74, 0x55, 0xf0, 0x80, 0x02, 0xe4, 0xf0, 0x20, 0x07, 0x06, 0x30, 0x06,
+    0x03, 0x30, 0x04, 0x05, 0x90, 0x30, 0x25, 0xe4, 0xf0, 0x22, 0x30, 0x04, 0x03, 0x02, 0x0e, 0x62,
+    0xd2, 0x04, 0xe5,
+    0x40, 0x8d, 0x80, 0x7d, 0xb4, 0x01, 0x06, 0x12, 0x15, 0x2c, 0x02, 0x0e, 0x5b, 0xe5, 0x7d, 0xb4,
+    0x02, 0x06, 0x12, 0x15, 0x3d, 0x02, 0x0e, 0x5b, 0xe5, 0x7d, 0xb4, 0x03, 0x05, 0xe4, 0xf5, 0x0c,
+    0x80, 0x08, 0xe5, 0x7d, 0xb4, 0x04, 0x09, 0x85, 0x7b, 0x0c, 0x12, 0x0f, 0x11, 0x02, 0x0e, 0x5b,
+    0xe5, 0x7d, 0x64, 0x0f, 0x70, 0x1f, 0x12, 0x02, 0xac, 0x40, 0x06, 0x7e, 0x00, 0x7f, 0xff, 0x80,
+    0x04, 0xae, 0x67,
+    0x40, 0x8d, 0xc0, 0xaf, 0x68, 0x12, 0x02, 0x58, 0xc3, 0x33, 0xce, 0x33, 0xce, 0xd8, 0xf9, 0x12,
+    0x0e, 0x63, 0x02, 0x0e, 0x5b, 0xe5, 0x7d, 0x64, 0x10, 0x60, 0x03, 0x02, 0x0e, 0x5b, 0xf5, 0x65,
+    0xf5, 0x66, 0xf5, 0x67, 0xab, 0x68, 0xaa, 0x67, 0xa9, 0x66, 0xa8, 0x65, 0x12, 0x01, 0xa0, 0xfe,
+    0xe4, 0xfc, 0xfd, 0x12, 0x01, 0xe7, 0xe4, 0x7b, 0xff, 0xfa, 0xf9, 0xf8, 0x12, 0x02, 0x6d, 0x85,
+    0x49, 0x82, 0x85,
+    0x40, 0x8e, 0x00, 0x48, 0x83, 0xe4, 0x93, 0xff, 0xe4, 0xfc, 0xfd, 0xfe, 0xe5, 0x68, 0x2f, 0xf5,
+    0x68, 0xee, 0x35, 0x67, 0xf5, 0x67, 0xed, 0x35, 0x66, 0xf5, 0x66, 0xec, 0x35, 0x65, 0xf5, 0x65,
+    0x12, 0x02, 0xac, 0x40, 0x04, 0x7f, 0xff, 0x80, 0x04, 0xae, 0x67, 0xaf, 0x68, 0x12, 0x02, 0x58,
+    0xc3, 0x33, 0xce, 0x33, 0xce, 0xd8, 0xf9, 0x12, 0x0e, 0x63, 0xe4, 0xf5, 0x66, 0xf5, 0x66, 0xe5,
+    0x66, 0xd3, 0x95,
+    0x40, 0x8e, 0x40, 0x7b, 0x50, 0x15, 0xaf, 0x66, 0xe5, 0x49, 0x2f, 0x12, 0x02, 0x4f, 0x93, 0xc3,
+    0x95, 0x68, 0xe4, 0x95, 0x67, 0x50, 0x04, 0x05, 0x66, 0x80, 0xe4, 0x85, 0x66, 0x7c, 0x90, 0x30,
+    0x25, 0xe4, 0xf0, 0xd2, 0x34, 0x22, 0xf5, 0x68, 0x8e, 0x67, 0x85, 0x67, 0x10, 0x85, 0x68, 0x11,
+    0x12, 0x09, 0xf8, 0x22, 0x12, 0x02, 0x85, 0xb5, 0x07, 0x03, 0xd3, 0x80, 0x01, 0xc3, 0x40, 0x03,
+    0x02, 0x0f, 0x10,
+    0x40, 0x8e, 0x80, 0x90, 0x30, 0x04, 0xe0, 0x44, 0x20, 0xf0, 0xa3, 0xe0, 0x44, 0x40, 0xf0, 0x90,
+    0x50, 0x25, 0xe0, 0x44, 0x04, 0xf0, 0x90, 0x50, 0x03, 0xe0, 0x54, 0xfd, 0xf0, 0x90, 0x50, 0x27,
+    0xe0, 0x44, 0x01, 0xf0, 0x90, 0x50, 0x31, 0xe4, 0xf0, 0x90, 0x50, 0x33, 0xf0, 0x90, 0x30, 0x1e,
+    0x12, 0x01, 0xfb, 0x90, 0x30, 0x18, 0x12, 0x01, 0xfb, 0x90, 0x30, 0x1b, 0x12, 0x01, 0xfb, 0xe0,
+    0xf5, 0x25, 0x90,
+    0x40, 0x8e, 0xc0, 0x30, 0x18, 0xe0, 0xf5, 0x21, 0x90, 0x60, 0x00, 0x74, 0xf5, 0xf0, 0x90, 0x3f,
+    0x01, 0xe4, 0xf0, 0xa3, 0xf0, 0x90, 0x3f, 0x01, 0xe0, 0x44, 0x08, 0xf0, 0xe0, 0x44, 0x20, 0xf0,
+    0x90, 0x3f, 0x05, 0x74, 0x30, 0xf0, 0xa3, 0x74, 0x24, 0xf0, 0x90, 0x3f, 0x0b, 0xe0, 0x44, 0x0f,
+    0xf0, 0x90, 0x3f, 0x01, 0xe0, 0x44, 0x02, 0xf0, 0xc2, 0x8c, 0x75, 0x89, 0x03, 0x75, 0xa8, 0x07,
+    0x75, 0xb8, 0x04,
+    0x40, 0x8f, 0x00, 0xe4, 0xf5, 0xd8, 0xf5, 0xe8, 0x90, 0x30, 0x01, 0xe0, 0x44, 0x40, 0xf0, 0xe0,
+    0x54, 0xbf, 0xf0, 0x22, 0xe5, 0x0c, 0xd3, 0x95, 0x7b, 0x40, 0x01, 0x22, 0xe5, 0x49, 0x25, 0x0c,
+    0x12, 0x02, 0x4f, 0x93, 0x75, 0x0d, 0x00, 0xf5, 0x0e, 0x45, 0x0d, 0x70, 0x05, 0x85, 0x64, 0x0f,
+    0x80, 0x1b, 0x12, 0x02, 0x9b, 0xc3, 0x33, 0xce, 0x33, 0xce, 0xd8, 0xf9, 0xf5, 0x0e, 0x8e, 0x0d,
+    0x85, 0x0d, 0x10,
+    0x40, 0x8f, 0x40, 0xf5, 0x11, 0x12, 0x09, 0xf8, 0x30, 0x33, 0x63, 0xc3, 0x22, 0xe5, 0x0f, 0xd3,
+    0x94, 0x10, 0x40, 0x33, 0xe5, 0x0f, 0xd3, 0x94, 0x60, 0x40, 0x05, 0x75, 0x0f, 0x58, 0x80, 0x11,
+    0xe5, 0x0f, 0xd3, 0x94, 0x40, 0x40, 0x04, 0x74, 0xf0, 0x80, 0x02, 0x74, 0xf8, 0x25, 0x0f, 0xf5,
+    0x0f, 0x75, 0x0d, 0x00, 0x85, 0x0f, 0x0e, 0x12, 0x02, 0x9b, 0xc3, 0x33, 0xce, 0x33, 0xce, 0xd8,
+    0xf9, 0xf5, 0x0e,
+    0x40, 0x8f, 0x80, 0x8e, 0x0d, 0x80, 0x0a, 0xe4, 0xf5, 0x0f, 0x75, 0x0d, 0x80, 0xf5, 0x0e, 0xf5,
+    0x64, 0x85, 0x0d, 0x10, 0x85, 0x0e, 0x11, 0x12, 0x09, 0xf8, 0x30, 0x33, 0x02, 0xc3, 0x22, 0xe5,
+    0x0f, 0x60, 0x0b, 0x75, 0x10, 0x00, 0x75, 0x11, 0x32, 0x12, 0x14, 0xcd, 0x80, 0x9f, 0x85, 0x0c,
+    0x7c, 0xd3, 0x22, 0x30, 0x3c, 0x09, 0x30, 0x20, 0x06, 0xae, 0x56, 0xaf, 0x57, 0x80, 0x04, 0xae,
+    0x69, 0xaf, 0x6a,
+    0x40, 0x8f, 0xc0, 0x8e, 0x56, 0x8f, 0x57, 0x30, 0x3c, 0x09, 0x30, 0x21, 0x06, 0xae, 0x58, 0xaf,
+    0x59, 0x80, 0x04, 0xae, 0x6b, 0xaf, 0x6c, 0x8e, 0x58, 0x8f, 0x59, 0x30, 0x3c, 0x09, 0x30, 0x22,
+    0x06, 0xae, 0x5a, 0xaf, 0x5b, 0x80, 0x04, 0xae, 0x6d, 0xaf, 0x6e, 0x8e, 0x5a, 0x8f, 0x5b, 0x30,
+    0x3c, 0x09, 0x30, 0x23, 0x06, 0xae, 0x5c, 0xaf, 0x5d, 0x80, 0x04, 0xae, 0x6f, 0xaf, 0x70, 0x8e,
+    0x5c, 0x8f, 0x5d,
+    0x40, 0x90, 0x00, 0x30, 0x3c, 0x09, 0x30, 0x24, 0x06, 0xae, 0x5e, 0xaf, 0x5f, 0x80, 0x04, 0xae,
+    0x71, 0xaf, 0x72, 0x8e, 0x5e, 0x8f, 0x5f, 0x30, 0x3c, 0x09, 0x30, 0x25, 0x06, 0xae, 0x60, 0xaf,
+    0x61, 0x80, 0x04, 0xae, 0x73, 0xaf, 0x74, 0x8e, 0x60, 0x8f, 0x61, 0x30, 0x3c, 0x09, 0x30, 0x26,
+    0x06, 0xae, 0x62, 0xaf, 0x63, 0x80, 0x04, 0xae, 0x75, 0xaf, 0x76, 0x8e, 0x62, 0x8f, 0x63, 0x22,
+    0xd3, 0xe5, 0x57,
+    0x40, 0x90, 0x40, 0x95, 0x6a, 0xe5, 0x56, 0x95, 0x69, 0x40, 0x03, 0xd3, 0x80, 0x01, 0xc3, 0x92,
+    0x20, 0xd3, 0xe5, 0x59, 0x95, 0x6c, 0xe5, 0x58, 0x95, 0x6b, 0x40, 0x03, 0xd3, 0x80, 0x01, 0xc3,
+    0x92, 0x21, 0xd3, 0xe5, 0x5b, 0x95, 0x6e, 0xe5, 0x5a, 0x95, 0x6d, 0x40, 0x03, 0xd3, 0x80, 0x01,
+    0xc3, 0x92, 0x22, 0xd3, 0xe5, 0x5d, 0x95, 0x70, 0xe5, 0x5c, 0x95, 0x6f, 0x40, 0x03, 0xd3, 0x80,
+    0x01, 0xc3, 0x92,
+    0x40, 0x90, 0x80, 0x23, 0xd3, 0xe5, 0x5f, 0x95, 0x72, 0xe5, 0x5e, 0x95, 0x71, 0x40, 0x03, 0xd3,
+    0x80, 0x01, 0xc3, 0x92, 0x24, 0xd3, 0xe5, 0x61, 0x95, 0x74, 0xe5, 0x60, 0x95, 0x73, 0x40, 0x03,
+    0xd3, 0x80, 0x01, 0xc3, 0x92, 0x25, 0xd3, 0xe5, 0x63, 0x95, 0x76, 0xe5, 0x62, 0x95, 0x75, 0x40,
+    0x03, 0xd3, 0x80, 0x01, 0xc3, 0x92, 0x26, 0x22, 0xe5, 0x0a, 0x70, 0x04, 0x7a, 0x11, 0x7b, 0xee,
+    0xe5, 0x0a, 0xb4,
+    0x40, 0x90, 0xc0, 0x01, 0x04, 0x7a, 0x12, 0x7b, 0x02, 0xe5, 0x0a, 0xb4, 0x02, 0x04, 0x7a, 0x12,
+    0x7b, 0x16, 0x8b, 0x82, 0x8a, 0x83, 0x12, 0x09, 0xc2, 0x8f, 0x37, 0x8e, 0x36, 0x8d, 0x35, 0x8c,
+    0x34, 0xe5, 0x82, 0x24, 0x04, 0xf5, 0x82, 0xe4, 0x35, 0x83, 0xf5, 0x83, 0x12, 0x09, 0xc2, 0x8f,
+    0x3b, 0x8e, 0x3a, 0x8d, 0x39, 0x8c, 0x38, 0xeb, 0x24, 0x08, 0x12, 0x02, 0x2f, 0x12, 0x01, 0x97,
+    0xeb, 0x24, 0x0c,
+    0x40, 0x91, 0x00, 0x12, 0x02, 0x2f, 0x8f, 0x43, 0x8e, 0x42, 0x8d, 0x41, 0x8c, 0x40, 0xeb, 0x24,
+    0x10, 0x12, 0x02, 0x2f, 0x8f, 0x47, 0x8e, 0x46, 0x8d, 0x45, 0x8c, 0x44, 0x22, 0x30, 0x3c, 0x07,
+    0x30, 0x20, 0x04, 0xaf, 0x4a, 0x80, 0x02, 0xaf, 0x7c, 0x8f, 0x4a, 0x30, 0x3c, 0x07, 0x30, 0x21,
+    0x04, 0xaf, 0x4b, 0x80, 0x02, 0xaf, 0x7c, 0x8f, 0x4b, 0x30, 0x3c, 0x07, 0x30, 0x22, 0x04, 0xaf,
+    0x4c, 0x80, 0x02,
+    0x40, 0x91, 0x40, 0xaf, 0x7c, 0x8f, 0x4c, 0x30, 0x3c, 0x07, 0x30, 0x23, 0x04, 0xaf, 0x4d, 0x80,
+    0x02, 0xaf, 0x7c, 0x8f, 0x4d, 0x30, 0x3c, 0x07, 0x30, 0x24, 0x04, 0xaf, 0x4e, 0x80, 0x02, 0xaf,
+    0x7c, 0x8f, 0x4e, 0x30, 0x3c, 0x07, 0x30, 0x25, 0x04, 0xaf, 0x4f, 0x80, 0x02, 0xaf, 0x7c, 0x8f,
+    0x4f, 0x30, 0x3c, 0x07, 0x30, 0x26, 0x04, 0xaf, 0x50, 0x80, 0x02, 0xaf, 0x7c, 0x8f, 0x50, 0x22,
+    0xe5, 0x7d, 0x64,
+    0x40, 0x91, 0x80, 0x01, 0x70, 0x47, 0xe5, 0x49, 0x25, 0x7c, 0x12, 0x01, 0xa4, 0xfe, 0xe4, 0x8f,
+    0x68, 0x8e, 0x67, 0xf5, 0x66, 0xf5, 0x65, 0x12, 0x01, 0xf2, 0x7b, 0xff, 0xfa, 0xf9, 0xf8, 0x12,
+    0x01, 0xe7, 0xc0, 0x05, 0xc0, 0x06, 0xc0, 0x07, 0x12, 0x01, 0xa0, 0xab, 0x07, 0xfa, 0xe4, 0xf9,
+    0xf8, 0xd0, 0x07, 0xd0, 0x06, 0xd0, 0x05, 0x12, 0x02, 0x6d, 0x85, 0x68, 0x65, 0x85, 0x7c, 0x66,
+    0xe5, 0x49, 0x25,
+    0x40, 0x91, 0xc0, 0x7c, 0x12, 0x02, 0x4f, 0x93, 0x75, 0x67, 0x00, 0xf5, 0x68, 0x90, 0x50, 0x82,
+    0xe5, 0x65, 0xf0, 0xa3, 0xe5, 0x66, 0xf0, 0xa3, 0xe5, 0x67, 0xf0, 0xa3, 0xe5, 0x68, 0xf0, 0x22,
+    0x56, 0x0c, 0x04, 0x00, 0x2a, 0x35, 0x40, 0x49, 0x52, 0x5b, 0x64, 0x6d, 0x76, 0x7f, 0x88, 0x91,
+    0x07, 0x20, 0x12, 0x28, 0x1e, 0x18, 0x18, 0x28, 0x1e, 0x18, 0x12, 0x28, 0x1e, 0x18, 0x12, 0x28,
+    0x18, 0x18, 0x12,
+    0x40, 0x92, 0x00, 0x20, 0x18, 0x28, 0x1c, 0x30, 0x24, 0x10, 0x1c, 0x18, 0x24, 0x1c, 0x14, 0x24,
+    0x1c, 0x28, 0x0c, 0x30, 0x14, 0x10, 0x0c, 0x18, 0x14, 0x1c, 0x20, 0x24, 0x28, 0x0c, 0x14, 0x14,
+    0x1c, 0x1c, 0x14, 0x24, 0x1c, 0x2c, 0x14, 0x34, 0x1c, 0x1c, 0x08, 0x24, 0x10, 0x19, 0x19, 0x1c,
+    0x19, 0x19, 0x10, 0x10, 0x10, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc2, 0x34, 0x20, 0x05,
+    0x05, 0x75, 0x0a,
+    0x40, 0x92, 0x40, 0xee, 0x80, 0x36, 0x20, 0x07, 0x08, 0x20, 0x06, 0x05, 0xe4, 0xf5, 0x0a, 0x80,
+    0x2b, 0x20, 0x07, 0x08, 0x30, 0x06, 0x05, 0x75, 0x0a, 0x20, 0x80, 0x20, 0x30, 0x00, 0x05, 0x75,
+    0x0a, 0x01, 0x80, 0x18, 0xe5, 0x20, 0x54, 0x07, 0xff, 0xbf, 0x06, 0x0d, 0x30, 0x31, 0x04, 0x7f,
+    0x12, 0x80, 0x02, 0x7f, 0x02, 0x8f, 0x0a, 0x80, 0x03, 0x75, 0x0a, 0xfe, 0x90, 0x30, 0x27, 0xe5,
+    0x0a, 0xf0, 0xe5,
+    0x40, 0x92, 0x80, 0x23, 0x54, 0xf8, 0xf5, 0x0a, 0xe5, 0x78, 0x25, 0x0a, 0xf5, 0x0a, 0x90, 0x30,
+    0x26, 0xe5, 0x0a, 0xf0, 0x22, 0xe5, 0x0a, 0x70, 0x04, 0x7e, 0x12, 0x7f, 0x2a, 0xe5, 0x0a, 0xb4,
+    0x01, 0x04, 0x7e, 0x12, 0x7f, 0x2f, 0xe5, 0x0a, 0xb4, 0x02, 0x04, 0x7e, 0x12, 0x7f, 0x34, 0x8f,
+    0x82, 0x8e, 0x83, 0xe4, 0x93, 0xf5, 0x2c, 0x74, 0x01, 0x93, 0xf5, 0x2d, 0x74, 0x02, 0x93, 0xf5,
+    0x2e, 0x74, 0x03,
+    0x40, 0x92, 0xc0, 0x93, 0xf5, 0x2f, 0x74, 0x04, 0x93, 0xf5, 0x30, 0xe5, 0x0a, 0xb4, 0x01, 0x07,
+    0x74, 0x2c, 0x25, 0x78, 0xf8, 0x76, 0x40, 0xe5, 0x0a, 0xb4, 0x02, 0x07, 0x74, 0x2c, 0x25, 0x78,
+    0xf8, 0x76, 0x80, 0x22, 0xc0, 0xe0, 0xc0, 0x83, 0xc0, 0x82, 0xc0, 0xd0, 0x90, 0x3f, 0x0d, 0xe0,
+    0xf5, 0x09, 0xe5, 0x09, 0x30, 0xe0, 0x2e, 0xe5, 0x79, 0xb4, 0x01, 0x09, 0x90, 0x3a, 0x00, 0xe0,
+    0xf5, 0x77, 0x44,
+    0x40, 0x93, 0x00, 0x01, 0xf0, 0xe5, 0x79, 0xb4, 0x03, 0x09, 0x90, 0x3a, 0x00, 0xe0, 0xf5, 0x77,
+    0x54, 0xfe, 0xf0, 0xe5, 0x79, 0xb4, 0x03, 0x05, 0x75, 0x79, 0x00, 0x80, 0x02, 0x05, 0x79, 0x90,
+    0x3f, 0x0d, 0x74, 0x01, 0xf0, 0xd0, 0xd0, 0xd0, 0x82, 0xd0, 0x83, 0xd0, 0xe0, 0x32, 0x90, 0x50,
+    0x27, 0xe0, 0x44, 0x01, 0xf0, 0x90, 0x50, 0x34, 0x74, 0x80, 0xf0, 0xa3, 0x74, 0x2a, 0xf0, 0xa3,
+    0x74, 0x14, 0xf0,
+    0x40, 0x93, 0x40, 0x90, 0x50, 0x30, 0xe4, 0xf0, 0xa3, 0x74, 0x02, 0xf0, 0xa3, 0xe4, 0xf0, 0xa3,
+    0x74, 0x80, 0xf0, 0xe4, 0xf5, 0x0a, 0x12, 0x10, 0xb5, 0x75, 0x78, 0x02, 0x75, 0x0a, 0x01, 0x12,
+    0x12, 0x92, 0xd2, 0x18, 0xd2, 0x19, 0xc2, 0x3a, 0xc2, 0x39, 0xd2, 0x1a, 0xd2, 0x36, 0xd2, 0x30,
+    0xc2, 0x35, 0xc2, 0x3b, 0x22, 0x85, 0x13, 0x14, 0x7f, 0x08, 0xe5, 0x14, 0x30, 0xe7, 0x04, 0xd2,
+    0x29, 0x80, 0x02,
+    0x40, 0x93, 0x80, 0xc2, 0x29, 0x12, 0x01, 0x6c, 0x75, 0x51, 0x0a, 0xae, 0x51, 0x15, 0x51, 0xee,
+    0x70, 0xf9, 0xe5, 0x14, 0x25, 0xe0, 0xf5, 0x14, 0xd2, 0x28, 0x12, 0x01, 0x6c, 0x75, 0x51, 0x0a,
+    0xae, 0x51, 0x15, 0x51, 0xee, 0x70, 0xf9, 0xc2, 0x28, 0x12, 0x01, 0x6c, 0x75, 0x51, 0x05, 0xae,
+    0x51, 0x15, 0x51, 0xee, 0x70, 0xf9, 0xdf, 0xc2, 0x22, 0xc2, 0xaf, 0x90, 0x30, 0x27, 0x74, 0xfa,
+    0xf0, 0x12, 0x0e,
+    0x40, 0x93, 0xc0, 0x71, 0x12, 0x14, 0x84, 0xe4, 0xf5, 0x33, 0xd2, 0xaf, 0x12, 0x0c, 0x69, 0x30,
+    0x30, 0x03, 0x12, 0x06, 0xdf, 0x30, 0x34, 0x03, 0x12, 0x12, 0x39, 0x30, 0x3b, 0xee, 0xc2, 0x3b,
+    0xd2, 0x35, 0x30, 0x00, 0x05, 0x12, 0x14, 0x57, 0x80, 0x09, 0x20, 0x07, 0x06, 0x30, 0x06, 0x03,
+    0x12, 0x0d, 0x77, 0xc2, 0x35, 0x80, 0xd5, 0x12, 0x10, 0x3d, 0xd2, 0x3c, 0x12, 0x0f, 0xb0, 0xd2,
+    0x3c, 0x12, 0x11,
+    0x40, 0x94, 0x00, 0x1a, 0xe5, 0x7b, 0xd3, 0x95, 0x7c, 0x40, 0x03, 0xd3, 0x80, 0x01, 0xc3, 0x50,
+    0x14, 0x20, 0x37, 0x0e, 0xe5, 0x24, 0x54, 0x1f, 0xff, 0xbf, 0x1f, 0x06, 0x30, 0x25, 0x03, 0x20,
+    0x26, 0x03, 0x02, 0x15, 0x2c, 0x12, 0x02, 0xb6, 0x22, 0xe5, 0x7c, 0x70, 0x19, 0x12, 0x15, 0x04,
+    0xc2, 0x3c, 0x12, 0x0f, 0xb0, 0xc2, 0x3c, 0x12, 0x11, 0x1a, 0xc2, 0x03, 0x12, 0x15, 0x2c, 0xd2,
+    0x02, 0xd2, 0x01,
+    0x40, 0x94, 0x40, 0xd2, 0x00, 0x22, 0x30, 0x03, 0x08, 0xc2, 0x03, 0xc2, 0x04, 0x12, 0x02, 0xa5,
+    0x22, 0xe4, 0xf5, 0x0c, 0x12, 0x0f, 0x11, 0xd2, 0x03, 0x22, 0xe5, 0x20, 0x54, 0x07, 0xff, 0xbf,
+    0x01, 0x03, 0x02, 0x14, 0x26, 0xe5, 0x20, 0x54, 0x07, 0xff, 0xbf, 0x07, 0x03, 0x02, 0x14, 0xaa,
+    0xe5, 0x20, 0x54, 0x07, 0xff, 0xbf, 0x03, 0x03, 0x02, 0x13, 0xf4, 0xe5, 0x20, 0x54, 0x07, 0xff,
+    0xbf, 0x05, 0x03,
+    0x40, 0x94, 0x80, 0x12, 0x15, 0x6a, 0x22, 0x12, 0x13, 0x2b, 0x12, 0x15, 0x78, 0x50, 0x04, 0xd2,
+    0x05, 0x80, 0x02, 0xc2, 0x05, 0x12, 0x02, 0x40, 0xc2, 0x37, 0xc2, 0x31, 0xd2, 0x34, 0x12, 0x02,
+    0x85, 0xb5, 0x07, 0x03, 0xd3, 0x80, 0x01, 0xc3, 0x40, 0x02, 0xc2, 0x05, 0x22, 0x12, 0x10, 0x3d,
+    0xd2, 0x3c, 0x12, 0x0f, 0xb0, 0xd2, 0x3c, 0x12, 0x11, 0x1a, 0x12, 0x15, 0x2c, 0xe5, 0x32, 0xd3,
+    0x95, 0x7c, 0x40,
+    0x40, 0x94, 0xc0, 0x05, 0xe4, 0x95, 0x7c, 0x40, 0x06, 0xc2, 0x02, 0xd2, 0x01, 0xd2, 0x00, 0x22,
+    0xe4, 0xff, 0xfe, 0xc3, 0xef, 0x95, 0x11, 0xee, 0x95, 0x10, 0x50, 0x15, 0x7d, 0x8a, 0x7c, 0x02,
+    0xed, 0x1d, 0xaa, 0x04, 0x70, 0x01, 0x1c, 0x4a, 0x70, 0xf6, 0x0f, 0xbf, 0x00, 0x01, 0x0e, 0x80,
+    0xe2, 0x22, 0x75, 0x48, 0x11, 0x75, 0x49, 0xe0, 0x90, 0x11, 0xde, 0xe4, 0x93, 0xf5, 0x7b, 0xa3,
+    0xe4, 0x93, 0xf5,
+    0x40, 0x95, 0x00, 0x32, 0xc2, 0x38, 0x22, 0xe4, 0xff, 0xef, 0x25, 0xe0, 0x24, 0x56, 0xf8, 0xe4,
+    0xf6, 0x08, 0xf6, 0x0f, 0xbf, 0x07, 0xf2, 0x53, 0x24, 0x80, 0x22, 0xc2, 0x03, 0xd2, 0x04, 0x12,
+    0x02, 0xa5, 0xc2, 0x3c, 0x12, 0x0f, 0xb0, 0xc2, 0x3c, 0x12, 0x11, 0x1a, 0xd2, 0x34, 0x22, 0xe5,
+    0x7c, 0xc3, 0x95, 0x7b, 0x40, 0x01, 0x22, 0xe5, 0x7c, 0x04, 0xf5, 0x0c, 0x12, 0x0f, 0x11, 0x22,
+    0xe5, 0x7c, 0x70,
+    0x40, 0x95, 0x40, 0x02, 0xc3, 0x22, 0xe5, 0x7c, 0x14, 0xf5, 0x0c, 0x12, 0x0f, 0x11, 0x22, 0xe5,
+    0x7d, 0xb4, 0x01, 0x09, 0x12, 0x14, 0xef, 0xe4, 0xf5, 0x0c, 0x12, 0x0f, 0x11, 0x22, 0xe5, 0x7d,
+    0x24, 0xfe, 0x60, 0x06, 0x04, 0x70, 0x05, 0xd2, 0x37, 0x22, 0xc2, 0x37, 0x22, 0xe5, 0x31, 0xd3,
+    0x94, 0x00, 0x40, 0x03, 0x15, 0x31, 0x22, 0x12, 0x15, 0x18, 0x22, 0x12, 0x14, 0xef, 0xe4, 0xf5,
+    0x0c, 0x12, 0x0f,
+    0x02, 0x95, 0x80, 0x11, 0x22,
+    0x02, 0x30, 0x24, 0x00, 0x00,
+    0x04, 0x50, 0x82, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x30, 0x26, 0x00, 0xff,
+    0x01, 0x30, 0x00, 0x00,
+    0x00,
+};
+
+#endif
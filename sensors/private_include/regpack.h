@@ -0,0 +1,52 @@
+/*
+ * Packed sensor register lists, kept in flash.
+ *
+ * The lists are generated from the uint16_t [][2] tables of the
+ * *_settings.h headers by tools/pack_sensor_regs.py. A list is a sequence of
+ * records, runs of registers at consecutive addresses share one record and
+ * go out in one SCCB burst:
+ *
+ *   n, addr[15:8], addr[7:0], value * n     n (1 to REGPACK_RUN_MAX) registers from addr up
+ *   REGPACK_DELAY, ms[15:8], ms[7:0]        wait, replaces REG_DLY
+ *   REGPACK_END                             end of the list, replaces REGLIST_TAIL
+ */
+#ifndef __REGPACK_H__
+#define __REGPACK_H__
+
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sccb.h"
+#include "reg_cache.h"
+
+#define REGPACK_END         0x00
+#define REGPACK_DELAY       0xFF
+#define REGPACK_RUN_MAX     SCCB_BURST_MAX
+
+static inline int regpack_write(uint8_t slv_addr, const uint8_t *regs)
+{
+    int ret = 0;
+    while (!ret && regs[0] != REGPACK_END) {
+        uint8_t n = regs[0];
+        uint16_t v = (regs[1] << 8) | regs[2];
+        regs += 3;
+        if (n == REGPACK_DELAY) {
+            vTaskDelay(v / portTICK_PERIOD_MS);
+        } else if (reg_cache_match(slv_addr, v, regs, n)) {
+            //already set, a mode switch only sends what differs
+        } else if (n == 1) {
+            ret = SCCB_Write16(slv_addr, v, regs[0]);
+        } else {
+            ret = SCCB_WriteBurst16(slv_addr, v, regs, n);
+        }
+        if (n != REGPACK_DELAY) {
+            if (ret == 0) {
+                reg_cache_set_burst(slv_addr, v, regs, n);
+            }
+            regs += n;
+        }
+    }
+    return ret;
+}
+
+#endif /* __REGPACK_H__ */
@@ -0,0 +1,122 @@
+#!/usr/bin/env python
+#
+# Convert the register lists of a sensor settings header (uint16_t [][2]
+# tables of address/value pairs) to the packed format played back by
+# regpack_write() in sensors/private_include/regpack.h.
+#
+# Usage: pack_sensor_regs.py ov5640
+#
+# Reads sensors/private_include/ov5640_settings.h (with the register names of
+# ov5640_regs.h) and writes sensors/private_include/ov5640_settings_packed.h.
+# Run it again after editing a settings header.
+
+import os
+import re
+import sys
+
+REGPACK_END = 0x00
+REGPACK_DELAY = 0xFF
+REGPACK_RUN_MAX = 64        # SCCB_BURST_MAX
+
+REG_DLY = 0xFFFF
+REGLIST_TAIL = 0x0000
+
+INCLUDE_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "sensors", "private_include")
+
+
+def strip_comments(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    return re.sub(r"//[^\n]*", "", text)
+
+
+def read_defines(path):
+    defines = {"REG_DLY": REG_DLY, "REGLIST_TAIL": REGLIST_TAIL}
+    with open(path) as f:
+        for m in re.finditer(r"^\s*#define\s+(\w+)\s+(0[xX][0-9a-fA-F]+|\d+)\b", strip_comments(f.read()), re.M):
+            defines.setdefault(m.group(1), int(m.group(2), 0))
+    return defines
+
+
+def value(token, defines):
+    token = token.strip()
+    if token in defines:
+        return defines[token]
+    return int(token, 0)
+
+
+def read_tables(path, defines):
+    with open(path) as f:
+        text = strip_comments(f.read())
+    tables = []
+    pattern = r"const\s+(?:DRAM_ATTR\s+)?uint16_t\s+(\w+)\s*\[\s*\]\s*\[\s*2\s*\]\s*=\s*\{(.*?)\n\s*\}\s*;"
+    for m in re.finditer(pattern, text, re.S):
+        regs = [(value(a, defines), value(v, defines))
+                for a, v in re.findall(r"\{\s*([^,{}]+?)\s*,\s*([^,{}]+?)\s*\}", m.group(2))]
+        tables.append((m.group(1), regs))
+    return tables
+
+
+def pack(regs):
+    records = []
+    i = 0
+    while i < len(regs) and regs[i][0] != REGLIST_TAIL:
+        addr, val = regs[i]
+        if addr == REG_DLY:
+            records.append([REGPACK_DELAY, val >> 8, val & 0xFF])
+            i += 1
+            continue
+        n = 1
+        while (n < REGPACK_RUN_MAX and i + n < len(regs)
+               and regs[i + n][0] == addr + n and regs[i + n][0] != REG_DLY):
+            n += 1
+        records.append([n, addr >> 8, addr & 0xFF] + [v & 0xFF for _, v in regs[i:i + n]])
+        i += n
+    records.append([REGPACK_END])
+    return records
+
+
+def write_header(path, sensor, tables):
+    guard = "_%s_SETTINGS_PACKED_H_" % sensor.upper()
+    out = []
+    out.append("/*")
+    out.append(" * Generated by tools/pack_sensor_regs.py from %s_settings.h, do not edit." % sensor)
+    out.append(" * Played back with regpack_write(), see regpack.h")
+    out.append(" */")
+    out.append("#ifndef %s" % guard)
+    out.append("#define %s" % guard)
+    out.append("")
+    out.append("#include <stdint.h>")
+    out.append("#include \"regpack.h\"")
+    for name, regs in tables:
+        records = pack(regs)
+        size = sum(len(r) for r in records)
+        count = sum(1 for a, _ in regs if a not in (REG_DLY, REGLIST_TAIL))
+        out.append("")
+        out.append("// %d registers in %d records, %d bytes" % (count, len(records) - 1, size))
+        out.append("static const uint8_t %s_packed[] = {" % name)
+        for r in records:
+            for j in range(0, len(r), 16):
+                out.append("    " + " ".join("0x%02x," % b for b in r[j:j + 16]))
+        out.append("};")
+    out.append("")
+    out.append("#endif")
+    with open(path, "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.stderr.write("usage: %s <sensor>\n" % sys.argv[0])
+        return 1
+    sensor = sys.argv[1]
+    defines = read_defines(os.path.join(INCLUDE_DIR, "%s_regs.h" % sensor))
+    tables = read_tables(os.path.join(INCLUDE_DIR, "%s_settings.h" % sensor), defines)
+    if not tables:
+        sys.stderr.write("no register lists found for %s\n" % sensor)
+        return 1
+    write_header(os.path.join(INCLUDE_DIR, "%s_settings_packed.h" % sensor), sensor, tables)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())